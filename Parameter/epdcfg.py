@@ -1,8 +1,41 @@
 import json
 import os
 import sys
+from datetime import datetime, timedelta
 from crc import Crc8, TableBasedCrcRegister, CrcRegister
 
+MAX_ALBUMS = 4
+ALBUM_NAME_MAX = 8
+MAX_TIMES = 4
+EPOCH = datetime(2000, 1, 1)
+
+def minute_of_day(value):
+    """minute of day from a number or a "HH:MM" string"""
+    if isinstance(value, str):
+        hours, minutes = value.split(':')
+        value = int(hours) * 60 + int(minutes)
+    if not 0 <= value < 1440:
+        raise ValueError('not a minute of day: {}'.format(value))
+    return value
+
+def album_bytes(album):
+    """7 parameters of an album definition, all 0 for an unused one"""
+    name = album.get('Name', '').encode('ascii')
+    if len(name) > ALBUM_NAME_MAX:
+        raise ValueError('album name too long: {}'.format(name))
+
+    result = bytearray(name.ljust(ALBUM_NAME_MAX, b'\0'))
+    result += album.get('Interval', 0).to_bytes(2, 'little')
+    result += minute_of_day(album.get('WindowStart', 0)).to_bytes(2, 'little')
+    result += minute_of_day(album.get('WindowEnd', 0)).to_bytes(2, 'little')
+    return result
+
+def clock_time(value):
+    """seconds since 2000-01-01 00:00 local time, "now" for the PC time"""
+    if 'now' == value:
+        return int((datetime.now() - EPOCH).total_seconds())
+    return value
+
 if __name__ == "__main__":
     if len(sys.argv) < 2:
         print('usage {}: <json file> [output]'.format(sys.argv[0]))
@@ -25,16 +58,64 @@ if __name__ == "__main__":
     minVoltage = json_data['Parameter']['MinVoltage']
     refVoltage = json_data['Parameter']['RefVoltage']
     supVoltage = json_data['Parameter']['SupVoltage']
+    cleanPolicy = json_data['Parameter'].get('CleanPolicy', 0)
+    cleanArg = json_data['Parameter'].get('CleanArg', 0)
+    overlayX = json_data['Parameter'].get('OverlayX', 0)
+    overlayY = json_data['Parameter'].get('OverlayY', 0xFFFF)
+    order = json_data['Parameter'].get('Order', 0)
+    albums = json_data['Parameter'].get('Albums', [])
+    rtcCal = json_data['Parameter'].get('RtcCalibration', 0)
+    time = clock_time(json_data['Parameter'].get('Time', 0))
+    quietStart = minute_of_day(json_data['Parameter'].get('QuietStart', 0))
+    quietEnd = minute_of_day(json_data['Parameter'].get('QuietEnd', 0))
+    times = [minute_of_day(t) for t in json_data['Parameter'].get('UpdateTimes', [])]
+    govVoltage = json_data['Parameter'].get('GovernorVoltage', 0)
+    govStretch = json_data['Parameter'].get('GovernorStretch', 100)
+
+    if len(albums) > MAX_ALBUMS:
+        print('at most {} albums supported'.format(MAX_ALBUMS))
+        exit(1)
+
+    if len(times) > MAX_TIMES:
+        print('at most {} update times supported'.format(MAX_TIMES))
+        exit(1)
 
     param_bytes += interval.to_bytes(2, 'little')
     param_bytes += minVoltage.to_bytes(2, 'little')
     param_bytes += refVoltage.to_bytes(2, 'little')
     param_bytes += supVoltage.to_bytes(2, 'little')
+    param_bytes += cleanPolicy.to_bytes(2, 'little')
+    param_bytes += cleanArg.to_bytes(2, 'little')
+    param_bytes += overlayX.to_bytes(2, 'little')
+    param_bytes += overlayY.to_bytes(2, 'little')
+    param_bytes += order.to_bytes(2, 'little')
+    param_bytes += len(albums).to_bytes(2, 'little')
+    for idx in range(MAX_ALBUMS):
+        param_bytes += album_bytes(albums[idx] if idx < len(albums) else {})
+    param_bytes += rtcCal.to_bytes(2, 'little', signed=True)
+    param_bytes += time.to_bytes(4, 'little')
+    param_bytes += quietStart.to_bytes(2, 'little')
+    param_bytes += quietEnd.to_bytes(2, 'little')
+    param_bytes += len(times).to_bytes(2, 'little')
+    for idx in range(MAX_TIMES):
+        param_bytes += (times[idx] if idx < len(times) else 0).to_bytes(2, 'little')
+    param_bytes += govVoltage.to_bytes(2, 'little')
+    param_bytes += govStretch.to_bytes(2, 'little')
 
     print('Interval   : {} minutes'.format(interval))
     print('MinVoltage : {} mV'.format(minVoltage))
     print('refVoltage : {} mV'.format(refVoltage))
     print('supVoltage : {} mV'.format(supVoltage))
+    print('cleanPolicy: {}'.format(cleanPolicy))
+    print('cleanArg   : {}'.format(cleanArg))
+    print('overlay    : {},{}'.format(overlayX, overlayY))
+    print('order      : {}'.format(order))
+    print('albums     : {}'.format(len(albums)))
+    print('rtcCal     : {} ppm'.format(rtcCal))
+    print('time       : {} ({})'.format(time, EPOCH + timedelta(seconds=time)))
+    print('quiet      : {}-{}'.format(quietStart, quietEnd))
+    print('times      : {}'.format(times))
+    print('governor   : {} mV {}%'.format(govVoltage, govStretch))
 
     # build header bytes
     crc8 = CrcRegister(Crc8.CCITT)
@@ -44,8 +125,8 @@ if __name__ == "__main__":
     header_bytes.append(69)   # E
     header_bytes.append(80)   # P
     header_bytes.append(68)   # D
-    header_bytes.append(1)    # version 1
-    header_bytes.append(4)    # 4 parameter
+    header_bytes.append(8)    # version 8
+    header_bytes.append(len(param_bytes) // 2)  # 50 parameter
     header_bytes.append(crc8.digest())  #  CRC
 
     print('crc        : 0x{:02x}'.format(crc8.digest()))
@@ -25,9 +25,46 @@ Example:
         $ python epdconv.py  img000.bmp img001.bmp
 
 This will create img00.epd and img001.epd on success.
+
+Each file starts with an 8 byte header:
+
+   0xFE, 'E', 'P', 'D', <version=2>, <encoding>, <flags>, 0x00
+
+encoding 0 is raw pixel data as above. The header ends with an info
+record describing the pixel data following it (16/32 bit little endian):
+
+   width, height, payload size, payload CRC, 0x0000
+
+The CRC is CRC-CCITT (polynomial 0x8408 reflected, init 0xFFFF) as
+computed by avr-libc's _crc_ccitt_update(). The frame skips files not
+matching the info record before touching the display.
+
+With option --rle the pixel data gets run length encoded (encoding 1).
+
+Each code byte describes a run of pixels with the same color:
+
+   0LLLLCCC            run of LLLL + 1 pixel (1..16)
+   1HHHHCCC LLLLLLLL   run of HHHHLLLLLLLL + 17 pixel (17..4112)
+
+The raw format is written instead if the encoding does not save space.
+
+With option --window=x,y,w,h[,color] only the given rectangle of the
+image is stored. The display shows the rest of the frame in the given
+color index (default 1 = white). The header gets flag 0x01 and a window
+record follows it, in front of the info record:
+
+   x, y, w, h (16 bit little endian), color, 0x00
+
+x and w must be even.
+
+With option --base=name.epd the display shows the named image of the
+same album outside the window instead of the color. The header gets
+flag 0x02 and the 8.3 file name, 0 padded to 12 bytes, follows the
+window record.
 """
 
 import os
+import struct
 from PIL import Image
 
 # Required image size
@@ -35,6 +72,35 @@ WIDTH=600
 HEIGHT=448
 COLORS=8
 
+# RLE encoding limits and file header
+RLE_SHORT_RUN=16
+RLE_LONG_RUN=4096 + RLE_SHORT_RUN
+
+# image header
+ENC_RAW=0
+ENC_RLE=1
+FLAG_WINDOW=0x01
+FLAG_BASE=0x02
+BASE_NAME_SIZE=12
+
+HEADER_VERSION=2
+
+def make_header(encoding, flags = 0):
+    "Create the 8 byte image header"
+    return bytes([0xFE, ord('E'), ord('P'), ord('D'), HEADER_VERSION, encoding, flags, 0])
+
+def crc_ccitt(data, crc = 0xFFFF):
+    "CRC-CCITT as avr-libc _crc_ccitt_update()"
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if (crc & 1) else (crc >> 1)
+    return crc
+
+def make_info(width, height, payload):
+    "Create the version 2 info record for the pixel data"
+    return struct.pack('<HHIHH', width, height, len(payload), crc_ccitt(payload), 0)
+
 # Default palette index mapping
 # Images may contain the palette colors in arbitrary order and
 # need to be mapped to match with the fixed EPD one
@@ -73,7 +139,55 @@ def map_palette(im : Image):
         rgb = (data[i], data[i + 1], data[i + 2])
         palette_index_map[i//3] = epd_palette[rgb]
 
-def convert(filename, im : Image) :
+def rle_encode(pixels):
+    "Run length encode a sequence of color index values"
+
+    data = bytearray()
+    pos = 0
+    while pos < len(pixels):
+        color = pixels[pos]
+        run = 1
+        while ((pos + run < len(pixels)) and (pixels[pos + run] == color) and
+               (run < RLE_LONG_RUN)):
+            run += 1
+        pos += run
+
+        if (run <= RLE_SHORT_RUN):
+            data.append(((run - 1) << 3) | color)
+        else:
+            run -= RLE_SHORT_RUN + 1
+            data.append(0x80 | ((run >> 8) << 3) | color)
+            data.append(run & 0xFF)
+
+    return data
+
+def parse_window(arg):
+    "Parse x,y,w,h[,color] window option into a tuple"
+
+    values = [int(v) for v in arg.split(',')]
+    if (len(values) == 4):
+        values.append(1)
+    if (len(values) != 5):
+        raise Exception("window needs x,y,w,h[,color]")
+
+    x, y, w, h, color = values
+    if ((x % 2) or (w % 2) or (w <= 0) or (h <= 0) or
+        (WIDTH < x + w) or (HEIGHT < y + h) or (COLORS <= color)):
+        raise Exception("invalid window {}".format(arg))
+
+    return (x, y, w, h, color)
+
+def make_base(name):
+    "Pack an 8.3 base image file name into a base record"
+
+    data = name.encode('ascii')
+    if ((0 == len(data)) or (BASE_NAME_SIZE < len(data)) or
+        ('/' in name) or ('\\' in name)):
+        raise Exception("invalid base image name {}".format(name))
+
+    return data.ljust(BASE_NAME_SIZE, b'\0')
+
+def convert(filename, im : Image, rle = False, window = None, base = None) :
     "convert image into epd  format and write it into a epd file"
 
     try:
@@ -83,9 +197,14 @@ def convert(filename, im : Image) :
         imgfile = open(outname, "wb")
 
         data = bytearray()
+        pixels = []
 
-        for y in range(0, HEIGHT):
-            for x in range(0, WIDTH, 2):
+        left, top, width, height = (0, 0, WIDTH, HEIGHT)
+        if (window):
+            left, top, width, height = window[0:4]
+
+        for y in range(top, top + height):
+            for x in range(left, left + width, 2):
                 ph = im.getpixel((x, y))
                 pl = im.getpixel((x + 1, y))
                 if ((COLORS <= ph) or (COLORS <= pl)) :
@@ -93,7 +212,29 @@ def convert(filename, im : Image) :
 
                 val = ((palette_index_map[ph] << 4) | palette_index_map[pl])
                 data.append(val)
-
+                pixels.append(palette_index_map[ph])
+                pixels.append(palette_index_map[pl])
+
+        flags = 0
+        record = bytes()
+        if (window):
+            flags = FLAG_WINDOW
+            record = struct.pack('<HHHHBB', *window, 0)
+            if (base):
+                flags |= FLAG_BASE
+                record += make_base(base)
+        header = (make_header(ENC_RAW, flags) + record +
+                  make_info(width, height, data))
+
+        if (rle):
+            encoded = rle_encode(pixels)
+            rle_header = (make_header(ENC_RLE, flags) + record +
+                          make_info(width, height, encoded))
+            if (len(rle_header) + len(encoded) < len(header) + len(data)):
+                header = rle_header
+                data = encoded
+
+        imgfile.write(header)
         imgfile.write(data)
         imgfile.close()
         print('Created epd image {}'.format(outname))
@@ -105,11 +246,30 @@ def convert(filename, im : Image) :
 if __name__ == "__main__":
     import sys
 
-    if len(sys.argv) <= 1:
-        print('usage {}: image_file [image_file]...'.format(sys.argv[0]))
+    args = sys.argv[1:]
+    rle = '--rle' in args
+    if rle:
+        args.remove('--rle')
+
+    window = None
+    for arg in args:
+        if arg.startswith('--window='):
+            window = parse_window(arg[len('--window='):])
+            args.remove(arg)
+            break
+
+    base = None
+    for arg in args:
+        if arg.startswith('--base='):
+            base = arg[len('--base='):]
+            args.remove(arg)
+            break
+
+    if (len(args) < 1) or (base and not window):
+        print('usage {}: [--rle] [--window=x,y,w,h[,color] [--base=name.epd]] image_file [image_file]...'.format(sys.argv[0]))
         exit(1)
 
-    for infile in sys.argv[1:]:
+    for infile in args:
         try:
             with Image.open(infile) as im:
                 if ((WIDTH != im.size[0]) or (HEIGHT != im.size[1])):
@@ -120,7 +280,7 @@ if __name__ == "__main__":
                     print('{}: wrong color format, need palette indexed'.format(infile))
                     continue
 
-                convert(infile, im)
+                convert(infile, im, rle, window, base)
 
         except OSError:
             pass
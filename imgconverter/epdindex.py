@@ -0,0 +1,213 @@
+"""
+epdindex - Create the image index file for an SD card
+
+
+The frame walks the /epd/img directory to find the next image, and
+opening an image by name scans the directory again. With many images
+on a card this takes longer than showing the image. The index file
+lists all images in directory order with their start cluster and
+size, so the frame can open image N without any directory access.
+
+The tool reads the FAT file system directly from the card device (or a
+disk image file), as the start clusters are not visible through a
+mounted file system. It writes the index into a file which must then be
+copied to the card as:
+
+   /epd/img.idx
+
+Copying the index does not move the images, so their clusters stay
+valid. Run the tool again after adding, removing or changing images.
+The frame falls back to directory scanning if it detects a stale
+index: another number of *.epd files in the directory or a cluster
+chain that does not fit the size.
+
+Index file layout (little endian):
+
+   'E', 'P', 'D', 'I', <version=2>, <reserved=0>, <count:16>, <files:16>
+   count * { <8.3 name:12, 0 padded>, <cluster:32>, <size:32> }
+
+files is the number of *.epd files in the directory, including empty
+ones that are not in the index.
+
+Example (Linux, card partition on /dev/sdb1):
+
+        $ sync
+        $ sudo python epdindex.py /dev/sdb1 img.idx
+        $ cp img.idx /media/user/CARD/epd/img.idx
+
+For an album directory /epd/<album> give the album name as third
+argument and copy the index to /epd/<album>.idx.
+"""
+
+import struct
+import sys
+
+INDEX_VERSION = 2
+IMAGE_DIR = 'EPD'
+DEFAULT_ALBUM = 'IMG'
+IMAGE_EXT = 'EPD'
+
+ATTR_VOLUME = 0x08
+ATTR_DIR = 0x10
+ATTR_LFN = 0x0F
+
+
+class FatVolume:
+    """Minimal read only FAT12/16/32 access"""
+
+    def __init__(self, dev):
+        self.dev = dev
+        self.base = 0
+
+        boot = self.read(0, 512)
+        if not self.is_fat(boot):
+            # partitioned media, use first partition from MBR
+            self.base = struct.unpack_from('<I', boot, 0x1C6)[0] * 512
+            boot = self.read(0, 512)
+            if not self.is_fat(boot):
+                raise ValueError('no FAT file system found')
+
+        (self.bps, self.spc, reserved, fats, root_entries, total16,
+            fat_size16, total32, fat_size32, root_cluster) = (
+            struct.unpack_from('<H', boot, 0x0B)[0], boot[0x0D],
+            struct.unpack_from('<H', boot, 0x0E)[0], boot[0x10],
+            struct.unpack_from('<H', boot, 0x11)[0],
+            struct.unpack_from('<H', boot, 0x13)[0],
+            struct.unpack_from('<H', boot, 0x16)[0],
+            struct.unpack_from('<I', boot, 0x20)[0],
+            struct.unpack_from('<I', boot, 0x24)[0],
+            struct.unpack_from('<I', boot, 0x2C)[0])
+
+        fat_size = fat_size16 if fat_size16 else fat_size32
+        total = total16 if total16 else total32
+        root_sectors = (root_entries * 32 + self.bps - 1) // self.bps
+
+        self.fat_start = reserved
+        self.root_start = reserved + fats * fat_size
+        self.data_start = self.root_start + root_sectors
+        self.clusters = (total - self.data_start) // self.spc
+
+        if self.clusters < 4085:
+            self.bits = 12
+        elif self.clusters < 65525:
+            self.bits = 16
+        else:
+            self.bits = 32
+
+        self.fat = self.read(self.fat_start * self.bps, fat_size * self.bps)
+
+        if 32 == self.bits:
+            self.root = self.read_chain(root_cluster)
+        else:
+            self.root = self.read(self.root_start * self.bps,
+                                  root_sectors * self.bps)
+
+    @staticmethod
+    def is_fat(boot):
+        return (boot[0x1FE:0x200] == b'\x55\xAA' and
+                struct.unpack_from('<H', boot, 0x0B)[0] in
+                    (512, 1024, 2048, 4096) and
+                0 != boot[0x0D])
+
+    def read(self, offset, size):
+        self.dev.seek(self.base + offset)
+        return self.dev.read(size)
+
+    def next_cluster(self, cluster):
+        if 12 == self.bits:
+            value = struct.unpack_from('<H', self.fat, cluster + cluster // 2)[0]
+            value = (value >> 4) if cluster & 1 else (value & 0xFFF)
+            return None if value >= 0xFF8 else value
+        if 16 == self.bits:
+            value = struct.unpack_from('<H', self.fat, cluster * 2)[0]
+            return None if value >= 0xFFF8 else value
+        value = struct.unpack_from('<I', self.fat, cluster * 4)[0] & 0x0FFFFFFF
+        return None if value >= 0x0FFFFFF8 else value
+
+    def read_chain(self, cluster):
+        data = bytearray()
+        size = self.spc * self.bps
+        while cluster is not None and 2 <= cluster < self.clusters + 2:
+            sector = self.data_start + (cluster - 2) * self.spc
+            data += self.read(sector * self.bps, size)
+            cluster = self.next_cluster(cluster)
+        return bytes(data)
+
+    @staticmethod
+    def entries(data):
+        """Yield (name, attr, cluster, size) in directory order"""
+        for ofs in range(0, len(data) - 31, 32):
+            entry = data[ofs:ofs + 32]
+            if 0x00 == entry[0]:
+                break
+            attr = entry[11]
+            if 0xE5 == entry[0] or ATTR_LFN == attr or (attr & ATTR_VOLUME):
+                continue
+            raw = bytearray(entry[0:11])
+            if 0x05 == raw[0]:
+                raw[0] = 0xE5
+            base = raw[0:8].decode('latin-1').rstrip()
+            ext = raw[8:11].decode('latin-1').rstrip()
+            name = base + ('.' + ext if ext else '')
+            cluster = ((struct.unpack_from('<H', entry, 20)[0] << 16) |
+                       struct.unpack_from('<H', entry, 26)[0])
+            size = struct.unpack_from('<I', entry, 28)[0]
+            yield name, attr, cluster, size
+
+    def find_dir(self, path):
+        data = self.root
+        for part in path:
+            for name, attr, cluster, size in self.entries(data):
+                if (attr & ATTR_DIR) and name.upper() == part:
+                    data = self.read_chain(cluster)
+                    break
+            else:
+                raise ValueError('directory /{} not found'.format('/'.join(path)))
+        return data
+
+
+def make_index(vol, album=DEFAULT_ALBUM):
+    """Build index bytes for all images of an album in directory order"""
+    entries = bytearray()
+    count = 0
+    files = 0
+
+    path = [IMAGE_DIR, album.upper()]
+    for name, attr, cluster, size in vol.entries(vol.find_dir(path)):
+        if (attr & ATTR_DIR) or not name.upper().endswith('.' + IMAGE_EXT):
+            continue
+        files += 1
+        if 0 == size or cluster < 2:
+            print('skipping empty file {}'.format(name))
+            continue
+        entries += struct.pack('<12sII', name.encode('latin-1'), cluster, size)
+        count += 1
+        print('{:5d}: {:12s} cluster {:8d} size {:8d}'.format(
+            count - 1, name, cluster, size))
+
+    if 0 == count or 0xFFFF < count:
+        raise ValueError('unsupported number of images: {}'.format(count))
+
+    return struct.pack('<4sBBHH', b'EPDI', INDEX_VERSION, 0, count,
+                       files) + entries
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print('usage {}: <card device or image> [output] [album]'.format(sys.argv[0]))
+        exit(1)
+
+    output_file = "img.idx"
+    if 3 <= len(sys.argv):
+        output_file = sys.argv[2]
+
+    album = DEFAULT_ALBUM
+    if 4 <= len(sys.argv):
+        album = sys.argv[3]
+
+    with open(sys.argv[1], 'rb') as dev:
+        index = make_index(FatVolume(dev), album)
+
+    print('\r\nStoring index into {}'.format(output_file))
+    with open(output_file, 'wb') as output:
+        output.write(index)
@@ -40,6 +40,8 @@
 #include "service/FileIo/FileIo.h"
 #include "service/Power/Power.h"
 #include "service/Led/Led.h"
+#include "service/Rtc/Rtc.h"
+#include "service/Stats/Stats.h"
 
 namespace app
 {
@@ -55,14 +57,17 @@ namespace app
     {
         service::init();
         service::Led::enable();
-        service::Power::resume(0u);
+        service::Power::resume();
+        service::Rtc::init();
+        STATS_BEGIN(PHASE_INIT);
         service::Power::idle(50);
         service::Led::disable();
     }
 
     void InitState::process(StateHandler& stateHandler)
     {
-        if ((!service::FileIo::init()) || (!service::FileIo::enable()))
+        /* card init first, the mount only checks its status */
+        if ((!service::FileIo::enable()) || (!service::FileIo::init()))
         {
             stateHandler.setState(ErrorState::instance());
         }
@@ -73,13 +78,29 @@ namespace app
                     Parameter::getRefVoltage(),
                     Parameter::getCalVoltage()
             );
-            
+            service::Rtc::setCalibration(Parameter::getRtcCalibration());
+            service::Rtc::setConfigTime(Parameter::getTime());
+            service::FileIo::setShuffle(
+                    Parameter::ORDER_SHUFFLE == Parameter::getPlayOrder());
+
+            /* continue with the album shown last */
+            uint8_t album(service::FileIo::getAlbum());
+            if (Parameter::getAlbumCount() <= album)
+            {
+                album = 0u;
+            }
+
             /* check for sufficient supply voltage
              */
             uint16_t supplyVoltage(service::Power::getSupplyVoltage_mV());
 
-
-            if (supplyVoltage < Parameter::getMinVoltage())
+            if (!service::FileIo::setAlbum(album,
+                    (0u != Parameter::getAlbumCount()) ?
+                        Parameter::getAlbum(album).name : nullptr))
+            {
+                stateHandler.setState(ErrorState::instance());
+            }
+            else if (supplyVoltage < Parameter::getMinVoltage())
             {
                 stateHandler.setState(LowBatState::instance());
             }
@@ -88,5 +109,7 @@ namespace app
                 stateHandler.setState(UpdateState::instance());
             }
         }
+
+        STATS_END(PHASE_INIT);
     }
 }
\ No newline at end of file
@@ -33,7 +33,9 @@
 #include "app/LowBatState.h"
 
 #include "service/Display/Display.h"
+#include "service/Display/PixelSource.h"
 #include "service/FileIo/FileIo.h"
+#include "service/Image/Image.h"
 #include "service/Power/Power.h"
 #include "service/Debug/Debug.h"
 #include "app/Parameter.h"
@@ -53,6 +55,11 @@ namespace app
      */
     static const char g_lowBatImgFile[] PROGMEM = "/epd/err/lb.epd";
 
+    /**
+     * @brief stripe width of the fallback pattern without image
+     */
+    static const uint16_t LOWBAT_STRIPE = 40u;
+
     LowBatState& LowBatState::instance()
     {
         return g_lowBatState;
@@ -67,6 +74,8 @@ namespace app
          */
         service::Epd::init();
 
+        bool painted(false);
+
         if (service::FileIo::enable())
         {
             char path[sizeof(g_lowBatImgFile)];
@@ -74,28 +83,27 @@ namespace app
 
             if (service::FileIo::open(path))
             {
-                uint16_t readRet(0u);
+                uint32_t total(0u);
 
-                service::Epd::beginPaint();
-
-                do {
-                    service::FileIo::read(
-                        service::FileIo::iobuf,
-                        service::FileIo::SHARED_BUF_SIZE, readRet);
-
-                    if (0u != readRet)
-                    {
-                        service::Epd::sendBlock(
-                            service::FileIo::iobuf,
-                            readRet);
-                    }
-                } while (0u != readRet);
+                painted = service::Image::prepare() &&
+                    service::Image::paint(total);
 
                 service::FileIo::close();
-                service::Epd::endPaint();
             }
         }
-        
+
+        if (!painted)
+        {
+            /* no usable image, show warning stripes instead */
+            service::PatternSource stripes(
+                service::Epd::getWidth(),
+                service::Epd::YELLOW, service::Epd::BLACK,
+                LOWBAT_STRIPE);
+
+            service::Epd::paint(stripes);
+        }
+        service::Epd::endPaint();
+
         service::Epd::sleep();
         service::FileIo::disable();
     }
@@ -106,19 +114,11 @@ namespace app
 
         /* sleep 10min before checking power state again.
          */
-        uint32_t loops(milli10min / service::Power::getSleepDurationMs());
-
-        DEBUG_LOGP(" LowBat: %ld loops \r\n",loops);
-
+        DEBUG_LOGP(" LowBat: sleep %ld ms\r\n", milli10min);
 
         service::Power::suspend();
-
-        while(loops--)
-        {
-            service::Power::sleep();
-        }
-    
-        service::Power::resume(milli10min);
+        service::Power::sleep(milli10min);
+        service::Power::resume();
 
 
         /* Resume if supply power is 50 mV higher than the low voltage
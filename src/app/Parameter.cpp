@@ -43,35 +43,47 @@ namespace app
      */
     static const char g_paramFile[] PROGMEM = "/epd/epd.cfg";
 
-    /** Version 1 header format
+    /** Header signature
      */
-    static const uint8_t g_headerV1[] PROGMEM = { 'E', 'P', 'D', 1u, 4u };
+    static const uint8_t g_signature[] PROGMEM = { 'E', 'P', 'D' };
 
-     /** Version 1 config file content
-      */
-    struct CfgFileV1
+    /** Newest supported parameter file version
+     */
+    static const uint8_t PARAM_VERSION = 8u;
+
+    /** Config file header
+     */
+    struct CfgHeader
     {
         char    signature[3];  /**< 'E' 'P' 'D'            */
-        uint8_t version;       /**< version(1)             */
-        uint8_t count;         /**< number of parameter(4) */
+        uint8_t version;       /**< version(1..8)          */
+        uint8_t count;         /**< number of parameter    */
         uint8_t crc8;          /**< CRC8 over parameter    */
-        union 
-        {
-            Parameter::ParamV1 param;
-            uint8_t bytes[sizeof(Parameter::ParamV1)];
-        } u;
     };
 
     /** Parameter runtime storage
      * 
      * Initialized with defaults 
      */
-    Parameter::ParamV1 Parameter::m_param = 
+    Parameter::ParamV8 Parameter::m_param = 
     {
         1440u,  /* Interval 1440 min = 1 day        */
         3300u,  /* low supply voltage limit         */
         1100u,  /* reference voltage                */
-        5000u   /* supply voltage during calibation */
+        5000u,  /* supply voltage during calibation */
+        Parameter::CLEAN_ALWAYS, /* clean policy    */
+        0u,     /* clean policy argument            */
+        0u,     /* overlay column                   */
+        0xFFFFu, /* overlay row, 0xFFFF = off       */
+        Parameter::ORDER_DIRECTORY, /* play order   */
+        0u,     /* no albums, show /epd/img         */
+        {},     /* album definitions                */
+        0u,     /* rtc calibration in ppm           */
+        0u,     /* time to set, low word            */
+        0u,     /* time to set, high word, 0 = none */
+        { 0u, 0u, 0u, {} }, /* no quiet hours and update times */
+        0u,     /* battery governor off             */
+        100u    /* no interval stretch              */
     };
 
     bool Parameter::init()
@@ -89,7 +101,14 @@ namespace app
         if (true == ioret)
         {
 
-            CfgFileV1 cfg;
+            CfgHeader cfg;
+            union
+            {
+                Parameter::ParamV8 param;
+                uint8_t bytes[sizeof(Parameter::ParamV8)];
+            } u;
+
+            u.param = m_param;  /* parameters missing in older files keep defaults */
 
             uint16_t read(0u);
             ioret = service::FileIo::read(&cfg, sizeof(cfg), read);
@@ -97,19 +116,25 @@ namespace app
 
             if ((true == ioret) && (sizeof(cfg) == read))
             {
+                const uint16_t size((uint16_t)cfg.count * sizeof(uint16_t));
+
                 /*  read ok, validate header and parameter CRC 
                  */
-                if (!memcmp_P(&cfg, g_headerV1, sizeof(g_headerV1)))
+                if (!memcmp_P(&cfg, g_signature, sizeof(g_signature)) &&
+                    (0u < cfg.version) && (cfg.version <= PARAM_VERSION) &&
+                    (0u < cfg.count) && (size <= sizeof(u.bytes)) &&
+                    service::FileIo::read(u.bytes, size, read) &&
+                    (size == read))
                 {
                     uint8_t crc8(0u);
-                    for (uint8_t i(0u); i < sizeof(Parameter::ParamV1); ++i)
+                    for (uint8_t i(0u); i < size; ++i)
                     {
-                        crc8 = _crc8_ccitt_update(crc8, cfg.u.bytes[i]);
+                        crc8 = _crc8_ccitt_update(crc8, u.bytes[i]);
                     }
                     
                     if (crc8 == cfg.crc8)
                     {
-                        m_param = cfg.u.param;    /* accept cfg file data*/
+                        m_param = u.param;    /* accept cfg file data*/
                         result = true;
                     }
                     else
@@ -136,6 +161,17 @@ namespace app
         DEBUG_LOGP("p.lowVoltage : %d mv\r\n", m_param.minVoltage);
         DEBUG_LOGP("p.refVoltage : %d mv\r\n", m_param.refVoltage);
         DEBUG_LOGP("p.supVoltage : %d mv\r\n", m_param.supVoltage);
+        DEBUG_LOGP("p.cleanPolicy: %d (%d)\r\n", m_param.cleanPolicy, m_param.cleanArg);
+        DEBUG_LOGP("p.overlay    : %u,%u\r\n", m_param.overlayX, m_param.overlayY);
+        DEBUG_LOGP("p.playOrder  : %u\r\n", m_param.playOrder);
+        DEBUG_LOGP("p.albums     : %u\r\n", m_param.albumCount);
+        DEBUG_LOGP("p.rtcCal     : %d ppm\r\n", getRtcCalibration());
+        DEBUG_LOGP("p.time       : %lu\r\n", getTime());
+        DEBUG_LOGP("p.quiet      : %u-%u\r\n",
+            m_param.schedule.quietStart, m_param.schedule.quietEnd);
+        DEBUG_LOGP("p.times      : %u\r\n", m_param.schedule.count);
+        DEBUG_LOGP("p.governor   : %u mV %u%%\r\n",
+            m_param.governorVoltage, m_param.governorStretch);
 
         return result;
     }
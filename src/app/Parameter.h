@@ -35,6 +35,9 @@
 
 #include <stdint.h>
 
+#include "service/FileIo/FileIo.h"
+#include "service/Schedule/Schedule.h"
+
 namespace app
 {
     /** Manage supported parameter to influence 
@@ -98,18 +101,185 @@ namespace app
              */
             static uint16_t getCalVoltage(void);
 
-             /** Initial (v1) parameter set Definition
-              */
-            struct ParamV1
+            /**
+             * @brief Policies for the anti ghosting clean refresh
+             */
+            enum CleanPolicy
+            {
+                CLEAN_ALWAYS      = 0u, /**< before every update               */
+                CLEAN_EVERY_N     = 1u, /**< before every N-th update          */
+                CLEAN_NEVER       = 2u, /**< only after power on               */
+                CLEAN_AFTER_SLEEP = 3u  /**< if last update is N minutes ago   */
+            };
+
+            /**
+             * @brief Get the clean refresh policy
+             *
+             * The display gets a full refresh with the "clean" color
+             * before showing the next image to avoid ghosting. This
+             * doubles the display energy per update. The policy defines
+             * when it is done. The first update after power on always
+             * cleans the display.
+             *
+             * @return CleanPolicy the policy, unknown values are
+             *                     treated as CLEAN_ALWAYS
+             */
+            static CleanPolicy getCleanPolicy(void);
+
+            /**
+             * @brief Get the clean policy argument
+             *
+             * Number of updates for CLEAN_EVERY_N, minutes for
+             * CLEAN_AFTER_SLEEP.
+             *
+             * @return uint16_t policy argument
+             */
+            static uint16_t getCleanArg(void);
+
+            /**
+             * @brief Check if the status overlay is enabled
+             *
+             * @return true  show status overlay
+             * @return false overlay off (OverlayY is 0xFFFF)
+             */
+            static bool hasOverlay(void);
+
+            /**
+             * @brief Get the status overlay position
+             *
+             * @param[out] x left column in pixel
+             * @param[out] y top row in pixel
+             */
+            static void getOverlayPos(uint16_t& x, uint16_t& y);
+
+            /**
+             * @brief Order to show the images in
+             */
+            enum PlayOrder
+            {
+                ORDER_DIRECTORY = 0u, /**< directory (or index) order      */
+                ORDER_SHUFFLE   = 1u  /**< random, each image once a round */
+            };
+
+            /**
+             * @brief Get the play order
+             *
+             * @return PlayOrder the order, unknown values are treated
+             *                   as ORDER_DIRECTORY
+             */
+            static PlayOrder getPlayOrder(void);
+
+            /**
+             * @brief Album definition
+             *
+             * While the clock is set, an album is only selected in its
+             * schedule window, unless no album is in its window.
+             */
+            struct Album
+            {
+                char     name[8];       /**< directory in /epd, 0 padded */
+                uint16_t interval;      /**< minutes, 0 = Interval       */
+                uint16_t windowStart;   /**< minute of day               */
+                uint16_t windowEnd;     /**< minute of day, = start: all */
+            };
+
+            /** Maximum number of albums */
+            static const uint8_t MAX_ALBUMS = service::FileIo::MAX_ALBUMS;
+
+            /**
+             * @brief Get the number of configured albums
+             *
+             * @return uint8_t albums, 0 shows /epd/img only
+             */
+            static uint8_t getAlbumCount(void);
+
+            /**
+             * @brief Get an album definition
+             *
+             * @param album album number below getAlbumCount()
+             * @return const Album& the definition
+             */
+            static const Album& getAlbum(uint8_t album);
+
+            /**
+             * @brief Get the update interval while showing an album
+             *
+             * @param album album number
+             * @return uint16_t minutes, the album interval if set,
+             *                  otherwise getInterval()
+             */
+            static uint16_t getAlbumInterval(uint8_t album);
+
+            /**
+             * @brief Get the real time clock calibration
+             *
+             * @return int16_t ppm to add, positive if the clock runs slow
+             */
+            static int16_t getRtcCalibration(void);
+
+            /**
+             * @brief Get the time to set the real time clock to
+             *
+             * @return uint32_t seconds since 2000-01-01 00:00, 0 if unset
+             */
+            static uint32_t getTime(void);
+
+            /**
+             * @brief Get the update schedule
+             *
+             * @return const service::Schedule::Table& update times and
+             *                                         quiet hours
+             */
+            static const service::Schedule::Table& getSchedule(void);
+
+            /**
+             * @brief Get the voltage to start stretching the interval at
+             *
+             * @return uint16_t knee voltage in mV, 0 if the battery
+             *                  governor is off
+             */
+            static uint16_t getGovernorVoltage(void);
+
+            /**
+             * @brief Get the interval stretch at the minimum voltage
+             *
+             * @return uint16_t stretch in percent
+             */
+            static uint16_t getGovernorStretch(void);
+
+            /** Version 8 parameter set Definition
+             *
+             * Version 1 defined the first 4 members, version 2 the
+             * first 6, version 3 the first 8, version 4 the first 9,
+             * version 5 the first 11, version 6 the first 14, version 7
+             * the first 15.
+             * Older parameter files provide a prefix of it, the
+             * remaining members keep their defaults. Albums count as
+             * 7 parameters each.
+             */
+            struct ParamV8
             {
                 uint16_t interval;
                 uint16_t minVoltage;
                 uint16_t refVoltage;
                 uint16_t supVoltage;
+                uint16_t cleanPolicy;
+                uint16_t cleanArg;
+                uint16_t overlayX;
+                uint16_t overlayY;
+                uint16_t playOrder;
+                uint16_t albumCount;
+                Album    albums[MAX_ALBUMS];
+                uint16_t rtcCalibration;
+                uint16_t timeLow;
+                uint16_t timeHigh;
+                service::Schedule::Table schedule;
+                uint16_t governorVoltage;
+                uint16_t governorStretch;
             };
 
         private:
-            static ParamV1 m_param;  /**< valid paramter during runtime */
+            static ParamV8 m_param;  /**< valid paramter during runtime */
     };
 
     inline uint16_t Parameter::getInterval(void) 
@@ -131,6 +301,77 @@ namespace app
     {
         return m_param.supVoltage;
     }
+
+    inline Parameter::CleanPolicy Parameter::getCleanPolicy(void)
+    {
+        return (CLEAN_AFTER_SLEEP < m_param.cleanPolicy) ?
+            CLEAN_ALWAYS : (CleanPolicy)m_param.cleanPolicy;
+    }
+
+    inline uint16_t Parameter::getCleanArg(void)
+    {
+        return m_param.cleanArg;
+    }
+
+    inline bool Parameter::hasOverlay(void)
+    {
+        return 0xFFFFu != m_param.overlayY;
+    }
+
+    inline void Parameter::getOverlayPos(uint16_t& x, uint16_t& y)
+    {
+        x = m_param.overlayX;
+        y = m_param.overlayY;
+    }
+
+    inline Parameter::PlayOrder Parameter::getPlayOrder(void)
+    {
+        return (ORDER_SHUFFLE < m_param.playOrder) ?
+            ORDER_DIRECTORY : (PlayOrder)m_param.playOrder;
+    }
+
+    inline uint8_t Parameter::getAlbumCount(void)
+    {
+        return (MAX_ALBUMS < m_param.albumCount) ?
+            MAX_ALBUMS : (uint8_t)m_param.albumCount;
+    }
+
+    inline const Parameter::Album& Parameter::getAlbum(uint8_t album)
+    {
+        return m_param.albums[album];
+    }
+
+    inline uint16_t Parameter::getAlbumInterval(uint8_t album)
+    {
+        return ((album < getAlbumCount()) &&
+                (0u != m_param.albums[album].interval)) ?
+            m_param.albums[album].interval : m_param.interval;
+    }
+
+    inline int16_t Parameter::getRtcCalibration(void)
+    {
+        return (int16_t)m_param.rtcCalibration;
+    }
+
+    inline uint32_t Parameter::getTime(void)
+    {
+        return ((uint32_t)m_param.timeHigh << 16u) | m_param.timeLow;
+    }
+
+    inline const service::Schedule::Table& Parameter::getSchedule(void)
+    {
+        return m_param.schedule;
+    }
+
+    inline uint16_t Parameter::getGovernorVoltage(void)
+    {
+        return m_param.governorVoltage;
+    }
+
+    inline uint16_t Parameter::getGovernorStretch(void)
+    {
+        return m_param.governorStretch;
+    }
 }
 
 #endif /* PARAMETER_H_INCLUDED */
\ No newline at end of file
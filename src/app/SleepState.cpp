@@ -40,12 +40,17 @@
 #include "service/Debug/Debug.h"
 #include "service/Power/Power.h"
 #include "service/FileIo/FileIo.h"
+#include "service/Rtc/Rtc.h"
+#include "service/Schedule/Schedule.h"
+#include "service/Governor/Governor.h"
+#include "service/Stats/Stats.h"
 
 
 static void printTime()
 {
 #if WITH_DEBUG != 0
-    uint32_t seconds(service::Power::uptime_mS() / 1000u);
+    uint32_t seconds(
+        service::Rtc::getTime() % service::Rtc::SECONDS_PER_DAY);
     uint32_t hours( seconds / 3600u);
     uint32_t minutes((seconds % 3600u) / 60);
 
@@ -55,10 +60,71 @@ static void printTime()
 }
 namespace app
 {
+    /**
+     * @brief Check if the time of day is in the album schedule window
+     *
+     * @param album album definition
+     * @return true  in window (or clock not set)
+     * @return false outside the window
+     */
+    static bool inAlbumWindow(const Parameter::Album& album)
+    {
+        return (!service::Rtc::isValid()) ||
+            service::Schedule::inRange(
+                service::Rtc::getMinuteOfDay(),
+                album.windowStart, album.windowEnd);
+    }
+
+    /**
+     * @brief Switch to the next album that has images
+     *
+     * Albums outside their schedule window are skipped, unless no
+     * album is inside its window. Only the directory of the selected
+     * album gets read, the others keep their position.
+     *
+     * @return true  album selected (or no albums configured)
+     * @return false no album has images
+     */
+    static bool selectNextAlbum(void)
+    {
+        const uint8_t count(Parameter::getAlbumCount());
+        const uint8_t current(service::FileIo::getAlbum());
+        bool result(count <= 1u);
+
+        for (uint8_t pass(0u); (!result) && (pass < 2u); ++pass)
+        {
+            for (uint8_t idx(1u); (!result) && (idx <= count); ++idx)
+            {
+                const uint8_t album((uint8_t)((current + idx) % count));
+                const Parameter::Album& def(Parameter::getAlbum(album));
+
+                if ((0u != pass) || inAlbumWindow(def))
+                {
+                    result = service::FileIo::setAlbum(album, def.name);
+                }
+            }
+        }
+
+        return result;
+    }
+
     static SleepState g_sleepState; /**< state instance */
     static uint32_t g_vsn;  /**< volume serial number when entering sleep */
-    static uint16_t g_loops = 0u; /**< number of sleep/wakeups to run */
-    static uint32_t  g_timeAdjust = 0ul; /**< lost ticks during sleep */
+    static uint32_t g_sleepMs = 0ul; /**< time to sleep */
+    static bool g_sdKept = false;   /**< SD card stayed powered during sleep */
+
+    /** Schedule without update times and quiet hours, used without clock */
+    static const service::Schedule::Table g_noSchedule = { 0u, 0u, 0u, {} };
+
+#if WITH_SD_KEEP_POWER != 0
+    /** Longest sleep time in minutes to keep the SD card powered.
+     *
+     * An idle card draws a few 100uA, a full card init at wakeup costs
+     * up to a second awake. For short intervals keeping the card is
+     * cheaper.
+     */
+    static const uint16_t SD_KEEP_MAX_MINUTES = 5u;
+#endif
 
     SleepState& SleepState::instance()
     {
@@ -74,34 +140,47 @@ namespace app
             g_vsn = 0u;
         }
 
-        if (!g_loops)
-        {
-            /* Calculate sleep loops to delay wanted minutes
-             */
-            uint32_t loops(Parameter::getInterval()); /* get minutes to sleep */
-            loops = (loops * 60000ul) / service::Power::getSleepDurationMs();
-            g_loops = (uint16_t)loops;
-            g_timeAdjust = loops * service::Power::getSleepDurationMs();
-
-            DEBUG_LOGP("sleep loops: %ld\r\n", loops);
-        }
+        /* albums may have their own interval, with the clock set the
+         * schedule defines the wakeup time. Weak batteries stretch it.
+         */
+        const uint16_t minutes(
+            Parameter::getAlbumInterval(service::FileIo::getAlbum()));
+        const uint16_t stretch(service::Governor::getStretch(
+            service::Power::getSupplyVoltage_mV(),
+            Parameter::getMinVoltage(),
+            Parameter::getGovernorVoltage(),
+            Parameter::getGovernorStretch()));
+        const uint32_t seconds(service::Schedule::getSleepSeconds(
+            service::Rtc::isValid() ? Parameter::getSchedule() : g_noSchedule,
+            service::Rtc::getTime(), minutes, stretch));
+
+        g_sleepMs = seconds * 1000ul;
+
+        DEBUG_LOGP("stretch: %u%%\r\n", stretch);
+
+        DEBUG_LOGP("sleep ms: %ld\r\n", g_sleepMs);
         printTime();
-        service::Power::suspend();
+
+#if WITH_SD_KEEP_POWER != 0
+        g_sdKept = (seconds <= SD_KEEP_MAX_MINUTES * 60u);
+#endif
+        STATS_REPORT();
+        STATS_BEGIN(PHASE_SLEEP);
+
+        service::Rtc::save();
+        service::Power::suspend(g_sdKept);
     }
     
     void SleepState::process(StateHandler& stateHandler)
     {
-        for (uint16_t i(g_loops); i != 0u; --i)
-        {
-            service::Power::sleep();
-        }
-
-        service::Power::resume(g_timeAdjust);
+        service::Power::sleep(g_sleepMs);
+        service::Power::resume();
+        STATS_END(PHASE_SLEEP);
 
         IState* nextState(&UpdateState::instance());
         uint32_t vsn(0ul); /* volume serial number */
 
-        if (!service::FileIo::enable())
+        if (!service::FileIo::enable(g_sdKept))
         {
             DEBUG_LOGP("file system error\r\n");
             nextState = &ErrorState::instance();
@@ -127,6 +206,11 @@ namespace app
                 nextState = &LowBatState::instance();
                 DEBUG_LOGP("low battery\r\n");
             }
+            else if (!selectNextAlbum())
+            {
+                DEBUG_LOGP("no album\r\n");
+                nextState = &ErrorState::instance();
+            }
         }
         
         stateHandler.setState(*nextState);
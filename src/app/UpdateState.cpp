@@ -35,13 +35,128 @@
 #include "service/Power/Power.h"
 #include "service/Display/Display.h"
 #include "service/FileIo/FileIo.h"
+#include "service/Image/Image.h"
+#include "service/Overlay/Overlay.h"
 #include "service/Debug/Debug.h"
+#include "service/Stats/Stats.h"
 #include "app/ErrorState.h"
 #include "app/SleepState.h"
+#include "app/Parameter.h"
 
 namespace app
 {
     static UpdateState g_updateState;
+    static bool g_cleaned = false;       /**< display cleaned since power on */
+    static uint16_t g_updates = 0u;      /**< updates since last clean       */
+    static uint32_t g_lastUpdate_ms = 0ul; /**< uptime of last update        */
+    static service::Overlay g_overlay;   /**< status text overlay            */
+
+    /** Supply voltage of a full LiPo battery */
+    static const uint16_t FULL_VOLTAGE_MV = 4200u;
+
+    /** Bad image files to skip per update */
+    static const uint8_t MAX_IMAGE_SKIPS = 3u;
+
+    /**
+     * @brief Open the current image, skip files failing the header check
+     *
+     * Runs before the display gets powered, so a bad file costs no
+     * refresh cycle.
+     *
+     * @return true  image open and prepared for Image::paint()
+     * @return false no usable image within MAX_IMAGE_SKIPS files
+     */
+    static bool selectImage(void)
+    {
+        for (uint8_t tries(0u); tries < MAX_IMAGE_SKIPS; ++tries)
+        {
+            if (service::FileIo::open())
+            {
+                if (service::Image::prepare())
+                {
+                    return true;
+                }
+                service::FileIo::close();
+            }
+
+            DEBUG_LOGP("skip %s\r\n", service::FileIo::getFileName());
+
+            if (!service::FileIo::next())
+            {
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Append a decimal number to a string
+     *
+     * @param pos    string position to write to
+     * @param value  number to append
+     * @param digits minimum number of digits (1..5)
+     * @return char* position after the number
+     */
+    static char * appendNumber(char * pos, uint16_t value, uint8_t digits)
+    {
+        char buf[5];
+        uint8_t count(0u);
+
+        do
+        {
+            buf[count++] = (char)('0' + (value % 10u));
+            value /= 10u;
+        } while ((0u != value) || (count < digits));
+
+        while (0u != count)
+        {
+            *pos++ = buf[--count];
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Build status text: battery, voltage, uptime and file name
+     *
+     * @param text buffer of Overlay::MAX_TEXT + 1 characters
+     */
+    static void buildStatus(char * text)
+    {
+        const uint16_t voltage(service::Power::getSupplyVoltage_mV());
+        const uint16_t minVoltage(Parameter::getMinVoltage());
+        uint8_t level(0u);
+
+        if ((voltage > minVoltage) && (FULL_VOLTAGE_MV > minVoltage))
+        {
+            level = (uint8_t)(((uint32_t)(voltage - minVoltage) *
+                (service::Overlay::BATTERY_LEVELS - 1u)) /
+                (FULL_VOLTAGE_MV - minVoltage));
+        }
+
+        const uint32_t hours(service::Power::uptime_mS() / 3600000ul);
+
+        char * pos(text);
+        *pos++ = service::Overlay::batteryIcon(level);
+        *pos++ = ' ';
+        pos = appendNumber(pos, voltage / 1000u, 1u);
+        *pos++ = '.';
+        pos = appendNumber(pos, (voltage % 1000u) / 10u, 2u);
+        *pos++ = 'V';
+        *pos++ = ' ';
+        pos = appendNumber(pos, (uint16_t)(hours / 24u), 1u);
+        *pos++ = 'D';
+        pos = appendNumber(pos, (uint16_t)(hours % 24u), 2u);
+        *pos++ = 'H';
+        *pos++ = ' ';
+
+        const char * name(service::FileIo::getFileName());
+        while (('\0' != *name) && (pos < &text[service::Overlay::MAX_TEXT]))
+        {
+            *pos++ = *name++;
+        }
+        *pos = '\0';
+    }
 
     UpdateState& UpdateState::instance()
     {
@@ -50,35 +165,65 @@ namespace app
 
     void UpdateState::process(StateHandler& stateHandler)
     {
+        STATS_BEGIN(PHASE_UPDATE);
+
+        if (service::Power::boost())
+        {
+            DEBUG_LOGP("Cpu: 8 Mhz\r\n");
+        }
+
         DEBUG_LOGP("Power: %d mV (ref: %d): \r\n",
                 service::Power::getSupplyVoltage_mV(),
                 service::Power::getReferenceVoltage_mV());
                 
         bool errorOccured(false) ;
 
-        DEBUG_LOGP("Epd::init()...");
-        if (!service::Epd::init())
+        STATS_BEGIN(PHASE_SELECT);
+        const bool selected(selectImage());
+        STATS_END(PHASE_SELECT);
+
+        if (!selected)
         {
-            DEBUG_LOGP("timeout!!\r\n");
-            errorOccured = true;
+            DEBUG_LOGP("no valid image\r\n");
+            service::FileIo::disable();
         }
         else
         {
-            DEBUG_LOGP("done\r\n");
-
-            service::Epd::clear(service::Epd::CLEAN);
+            DEBUG_LOGP("Epd::init()...");
             if (!service::Epd::init())
             {
                 DEBUG_LOGP("timeout!!\r\n");
+                service::FileIo::close();
                 errorOccured = true;
             }
-            
-            if (!updateScreen())
+            else
             {
-                errorOccured = true;
+                DEBUG_LOGP("done\r\n");
+
+                if (needsClean())
+                {
+                    service::Epd::clear(service::Epd::CLEAN);
+                    if (!service::Epd::init())
+                    {
+                        DEBUG_LOGP("timeout!!\r\n");
+                        errorOccured = true;
+                    }
+                    g_cleaned = true;
+                    g_updates = 0u;
+                }
+
+                ++g_updates;
+                g_lastUpdate_ms = service::Power::uptime_mS();
+
+                if (!updateScreen())
+                {
+                    errorOccured = true;
+                }
             }
         }
 
+        STATS_END(PHASE_UPDATE);
+
         if (errorOccured)
         {
             stateHandler.setState(ErrorState::instance());
@@ -89,38 +234,74 @@ namespace app
         }
     }
 
+    bool UpdateState::needsClean(void)
+    {
+        bool result(true);
+
+        if (g_cleaned)  /* display content unknown after power on */
+        {
+            switch (Parameter::getCleanPolicy())
+            {
+                case Parameter::CLEAN_EVERY_N:
+                    result = (Parameter::getCleanArg() <= g_updates);
+                    break;
+
+                case Parameter::CLEAN_NEVER:
+                    result = false;
+                    break;
+
+                case Parameter::CLEAN_AFTER_SLEEP:
+                    result = ((uint32_t)Parameter::getCleanArg() * 60000ul) <=
+                        (service::Power::uptime_mS() - g_lastUpdate_ms);
+                    break;
+
+                case Parameter::CLEAN_ALWAYS:
+                default:
+                    break;
+            }
+        }
+
+        DEBUG_LOGP("clean: %d\r\n", result);
+
+        return result;
+    }
+
     bool UpdateState::updateScreen(void)
     {
         bool result(true);
 
         DEBUG_LOGP("File %s\r\n", service::FileIo::getFileName());
 
-        DEBUG_LOGP("Epd::beginPaint()...");
-        service::Epd::beginPaint();
-        DEBUG_LOGP("done\r\n");
+        service::Overlay * overlay(nullptr);
 
-        if (service::FileIo::open())
+        if (Parameter::hasOverlay())
         {
-            uint16_t readRet(0u);
-            uint32_t total(0);
+            char text[service::Overlay::MAX_TEXT + 1u];
+            uint16_t x;
+            uint16_t y;
 
-            do {
-                service::FileIo::read(
-                    service::FileIo::iobuf,
-                    service::FileIo::SHARED_BUF_SIZE, readRet);
+            buildStatus(text);
+            Parameter::getOverlayPos(x, y);
 
-                if (0u != readRet)
-                {
-                    service::Epd::sendBlock(
-                        service::FileIo::iobuf, readRet);
-                    total += readRet;
-                }
-            } while (0u != readRet);
+            g_overlay.begin(
+                service::Epd::getWidth(), service::Epd::getHeight(),
+                x, y, text,
+                service::Epd::BLACK, service::Epd::WHITE);
+            overlay = &g_overlay;
+        }
 
-            service::FileIo::close();
+        /* image file is open and prepared, @see selectImage() */
+        uint32_t total(0);
 
-            DEBUG_LOGP("read %ld\r\n", total);
-        }
+        DEBUG_LOGP("Image::paint()...");
+        STATS_BEGIN(PHASE_STREAM);
+        const bool painted(service::Image::paint(total, overlay));
+        STATS_END(PHASE_STREAM);
+        DEBUG_LOGP("%d\r\n", painted);
+
+        service::FileIo::close();
+
+        DEBUG_LOGP("read %ld\r\n", total);
 
         if (!service::FileIo::next())
         {
@@ -130,9 +311,14 @@ namespace app
 
         service::FileIo::disable();
 
-        DEBUG_LOGP("Epd::endPaint()...");
-        service::Epd::endPaint();
-        DEBUG_LOGP("done\r\n");
+        if (painted)
+        {
+            DEBUG_LOGP("Epd::endPaint()...");
+            STATS_BEGIN(PHASE_REFRESH);
+            service::Epd::endPaint();
+            STATS_END(PHASE_REFRESH);
+            DEBUG_LOGP("done\r\n");
+        }
         service::Epd::sleep();
 
         return result;
@@ -51,12 +51,24 @@ namespace app
 
         protected:
             /**
-             * @brief Update screen with next picture
+             * @brief Update screen with the open, prepared picture
+             *
+             * Closes the image file and advances to the next one.
              * 
              * @return true 
              * @return false 
              */
             virtual bool updateScreen(void);
+
+            /**
+             * @brief Check if a clean refresh is due before the update
+             *
+             * @see Parameter::getCleanPolicy()
+             *
+             * @return true  clean the display first
+             * @return false paint over the previous image
+             */
+            bool needsClean(void);
     };
 }
 
@@ -31,6 +31,7 @@
  */
 
 #include "Adc.h"
+#include "hal/Cpu/Cpu.h"
 
 #include <avr/power.h>
 #include <avr/io.h>
@@ -83,12 +84,15 @@ namespace hal
          * No AutoTrigger (0 = ADATE)
          * No interrupts (0=ADIF, 0= ADIE) 
          * Prescaler 32 (101b): 4Mhz / 32 = 125khz
+         * Prescaler 64 (110b): 8Mhz / 64 = 125khz at Cpu::CLK_FAST
          */
         ADCSRA = (1 << ADEN)
                 | (0 << ADSC)
                 | (0 << ADATE)
                 | (0 << ADIF) | (0 << ADIE)
-                | (1 << ADPS2) | (0 << ADPS1) | (1 << ADPS0);  
+                | ((Cpu::CLK_FAST == Cpu::getClock()) ?
+                    ((1 << ADPS2) | (1 << ADPS1) | (0 << ADPS0)) :
+                    ((1 << ADPS2) | (0 << ADPS1) | (1 << ADPS0)));
 
         _delay_us(500);    /* wait for selected voltages to stabilize */
 
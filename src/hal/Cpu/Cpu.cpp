@@ -39,6 +39,9 @@
 
 namespace hal
 {
+    Cpu::Clock Cpu::m_clock = Cpu::CLK_NORMAL;
+    uint8_t Cpu::m_resetCause = 0u;
+
     void Cpu::setClock(Clock clkMode)
     {
         switch (clkMode)
@@ -50,7 +53,18 @@ namespace hal
             case CLK_SLEEP:
                 clock_prescale_set(clock_div_256);   /* 31.25 Khz, slowest possible clock */
                 break;
+
+            case CLK_FAST:
+#if F_CPU == 4000000
+                clock_prescale_set(clock_div_1);     /* 8 Mhz internal clock */
+                break;
+#else
+                return;                              /* no fast profile */
+#endif
         }
+
+        m_clock = clkMode;
+        TickTimer::updateClock();
     }
 
     void Cpu::halt(void)
@@ -113,4 +127,16 @@ namespace hal
         }
     }
 
+    void Cpu::clearResetCause(void)
+    {
+        m_resetCause = MCUSR;
+        MCUSR = 0x00;
+    }
+
+    bool Cpu::isSoftReset(void)
+    {
+        return (0u != (m_resetCause & _BV(WDRF))) &&
+            (0u == (m_resetCause & (_BV(PORF) | _BV(BORF) | _BV(EXTRF))));
+    }
+
 } // namespace hal
@@ -54,7 +54,8 @@ namespace hal
         enum Clock
         {
             CLK_NORMAL,     /**< configure cpu clock for normal operation */
-            CLK_SLEEP       /**< configure cpu clock for sleep operation  */
+            CLK_SLEEP,      /**< configure cpu clock for sleep operation  */
+            CLK_FAST        /**< double speed for busy phases, >= 2.7V    */
         };
 
         /**
@@ -83,6 +84,11 @@ namespace hal
         inline static void delayMS(uint16_t ms)
         {
             _delay_ms(ms);
+
+            if (CLK_FAST == m_clock)
+            {
+                _delay_ms(ms);  /* delays are calculated for F_CPU */
+            }
         }
 
         /**
@@ -92,6 +98,19 @@ namespace hal
          */
         static void setClock(Clock clkMode);
 
+        /**
+         * @brief Get the current CPU clock mode
+         *
+         * Peripheral drivers use it to pick their clock dependent
+         * register values.
+         *
+         * @return Clock current mode
+         */
+        inline static Clock getClock()
+        {
+            return m_clock;
+        }
+
         /** Halt (shutdown) cpu/system
          */
         static void halt(void);
@@ -108,6 +127,21 @@ namespace hal
          */
         static void reset(void);
 
+        /**
+         * @brief Store and clear the reset cause flags
+         *
+         * Called once at start up, @see hal::init
+         */
+        static void clearResetCause(void);
+
+        /**
+         * @brief Check if the last reset came from reset()
+         *
+         * @return true  watchdog reset only, RAM kept its content
+         * @return false power on, brown out or external reset
+         */
+        static bool isSoftReset(void);
+
         /**
          * @brief Get the Idle time for one tick in ms.
          * 
@@ -123,6 +157,11 @@ namespace hal
          * @param ticks How often to enter idle
          */ 
         static void enterIdle(uint8_t ticks);
+
+        private:
+
+        static Clock m_clock;   /**< current clock mode */
+        static uint8_t m_resetCause; /**< MCUSR at start up */
     };
 }
 #endif /* CPU_H_INCLUDED */
\ No newline at end of file
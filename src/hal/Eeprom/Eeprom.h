@@ -0,0 +1,84 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EEPROM_H_INCLUDED
+#define EEPROM_H_INCLUDED
+
+#include <stdint.h>
+#include <avr/eeprom.h>
+
+namespace hal
+{
+    /**
+     * @brief Access to the internal EEPROM
+     *
+     * Data locations are allocated with EEMEM. Writes block until the
+     * EEPROM is done, ~3.4ms per changed byte.
+     */
+    class Eeprom
+    {
+        public:
+
+            /**
+             * @brief Read a block from EEPROM
+             *
+             * @param dst  RAM destination
+             * @param src  EEPROM source address
+             * @param size number of bytes
+             */
+            inline static void read(void * dst, const void * src, uint16_t size)
+            {
+                eeprom_read_block(dst, src, size);
+            }
+
+            /**
+             * @brief Write a block into EEPROM
+             *
+             * Only bytes that differ get written to save EEPROM cycles.
+             *
+             * @param dst  EEPROM destination address
+             * @param src  RAM source
+             * @param size number of bytes
+             */
+            inline static void update(void * dst, const void * src, uint16_t size)
+            {
+                eeprom_update_block(src, dst, size);
+            }
+
+        private:
+            Eeprom();
+            Eeprom(const Eeprom&);
+            Eeprom& operator=(const Eeprom&);
+    };
+}
+
+#endif /* EEPROM_H_INCLUDED */
@@ -31,6 +31,7 @@
  */
 
 #include "hal/Gpio/Gpio.h"
+#include <avr/interrupt.h>
 
 namespace hal
 {
@@ -65,4 +66,13 @@ namespace hal
 #endif
         DDRD  = _BV(PD6) | _BV(PD5) | _BV(PD4) | _BV(PD3) | _BV(PD2) | _BV(PD1) | _BV(PD0);
     }
-}
\ No newline at end of file
+}
+
+/** display busy pin change handler
+ *
+ * Nothing to do here, the interrupt only ends CPU sleep. Callers
+ * read the pin state after wakeup.
+ */
+ISR(PCINT2_vect)
+{
+}
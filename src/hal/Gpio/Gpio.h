@@ -90,6 +90,29 @@ namespace hal
         inline static void clrDispPow()      { PORTD &= ~_BV(DISP_POW);   }
 
         inline static bool getDispBusy()     { return (PIND & _BV(DISP_BUSY)) ? true : false ; }
+
+        /**
+         * @brief Wake up CPU on display busy pin changes
+         *
+         * Enables the pin change interrupt of the BUSYN line (PCINT23),
+         * so that the CPU can leave power save when the display
+         * finishes an operation.
+         */
+        inline static void enableDispBusyIrq()
+        {
+            PCMSK2 |= _BV(PCINT23);
+            PCIFR   = _BV(PCIF2);   /* drop stale change events */
+            PCICR  |= _BV(PCIE2);
+        }
+
+        /**
+         * @brief Stop waking up CPU on display busy pin changes
+         */
+        inline static void disableDispBusyIrq()
+        {
+            PCICR  &= ~_BV(PCIE2);
+            PCMSK2 &= ~_BV(PCINT23);
+        }
     };
 }
 #endif /* GPIO_H_INCLUDED */
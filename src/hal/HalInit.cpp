@@ -32,6 +32,8 @@
 
 #include "hal/HalInit.h"
 #include "hal/Gpio/Gpio.h"
+#include "hal/Cpu/Cpu.h"
+#include "hal/Timer/WakeUpTimer.h"
 
 #include <avr/io.h>
 #include <avr/power.h>
@@ -48,13 +50,15 @@ namespace hal
     void init()
     {
         
-        /* no watchdog */
-        MCUSR = 0x00;
+        /* no watchdog, keep the reset cause for later checks */
+        hal::Cpu::clearResetCause();
         wdt_disable();
         
         hal::Gpio::init();
 
         configurePower();
+
+        hal::WakeUpTimer::init(); /* time base, runs from first resume */
     }
 }
 
@@ -32,6 +32,7 @@
  */
 
 #include "Spi.h"
+#include "hal/Cpu/Cpu.h"
 
 #include "service/Debug/Debug.h"
 
@@ -48,7 +49,7 @@
  */
 static inline void waitTXcomplete();
 
-/** SPI clock settings 
+/** SPI clock settings per CPU clock profile (normal, fast)
  * 
  * Note: 1Mhz CPU can only go up to 1Mhz SPIU
  */
@@ -56,16 +57,34 @@ static const struct ClockSettings
 {
     uint8_t divider;   /**< clock divder settings in SPCR */
     uint8_t use2X;     /**< enable/disable 2x mode        */
-} g_ClkParam[] PROGMEM = 
+} g_ClkParam[2][hal::Spi::CLK_COUNT] PROGMEM = 
 {
 #if F_CPU == 1000000
-    {  (0 << SPR1) | (0 << SPR0), 0u  }, /* CLK_250000, fosc/4     */
-    {  (0 << SPR1) | (0 << SPR0), 0u } , /* CLK_1000000 fosc/2 * 2 */
-    {  (0 << SPR1) | (0 << SPR0), 0u  }, /* CLK_2000000 fosc/2 * 2 */
+    {
+        {  (0 << SPR1) | (0 << SPR0), 0u  }, /* CLK_250000, fosc/4     */
+        {  (0 << SPR1) | (0 << SPR0), 0u } , /* CLK_1000000 fosc/2 * 2 */
+        {  (0 << SPR1) | (0 << SPR0), 0u  }, /* CLK_2000000 fosc/2 * 2 */
+        {  (0 << SPR1) | (0 << SPR0), 0u  }, /* CLK_4000000 fosc/2 * 2 */
+    },
+    {
+        {  (0 << SPR1) | (0 << SPR0), 0u  }, /* no fast profile        */
+        {  (0 << SPR1) | (0 << SPR0), 0u } ,
+        {  (0 << SPR1) | (0 << SPR0), 0u  },
+        {  (0 << SPR1) | (0 << SPR0), 0u  },
+    }
 #elif F_CPU == 4000000
-    {  (0 << SPR1) | (1 << SPR0), 0u }, /* CLK_250000, fosc/16    */
-    {  (0 << SPR1) | (0 << SPR0), 0u }, /* CLK_1000000 fosc/4     */
-    {  (0 << SPR1) | (0 << SPR0), 1u }, /* CLK_2000000 fosc/4 * 2 */
+    {
+        {  (0 << SPR1) | (1 << SPR0), 0u }, /* CLK_250000, fosc/16    */
+        {  (0 << SPR1) | (0 << SPR0), 0u }, /* CLK_1000000 fosc/4     */
+        {  (0 << SPR1) | (0 << SPR0), 1u }, /* CLK_2000000 fosc/4 * 2 */
+        {  (0 << SPR1) | (0 << SPR0), 1u }, /* CLK_4000000 fosc/4 * 2 */
+    },
+    {   /* Cpu::CLK_FAST, 8 Mhz */
+        {  (1 << SPR1) | (0 << SPR0), 1u }, /* CLK_250000, fosc/64 * 2 */
+        {  (0 << SPR1) | (1 << SPR0), 1u }, /* CLK_1000000 fosc/16 * 2 */
+        {  (0 << SPR1) | (0 << SPR0), 0u }, /* CLK_2000000 fosc/4      */
+        {  (0 << SPR1) | (0 << SPR0), 1u }, /* CLK_4000000 fosc/4 * 2  */
+    }
 #else
 #error unsupported clock speed
 #endif
@@ -148,9 +167,12 @@ namespace hal
         
         /* clock settings */
         localSPCR &= ~(_BV(SPR1) | _BV(SPDR0));
-        localSPCR |= pgm_read_byte(&(g_ClkParam[clock].divider));
+        const ClockSettings * settings(
+            &g_ClkParam[(Cpu::CLK_FAST == Cpu::getClock()) ? 1u : 0u][clock]);
+
+        localSPCR |= pgm_read_byte(&(settings->divider));
 
-        if (0u != pgm_read_byte(&(g_ClkParam[clock].use2X)))
+        if (0u != pgm_read_byte(&(settings->use2X)))
         {
             SPSR |= _BV(SPI2X);
         }
@@ -174,12 +196,7 @@ namespace hal
             m_slaveSelect(true);
         }
 
-        for (uint16_t idx(0u); 0u != size; --size)
-        {
-            SPDR = 0xFF;            // dummy write to generate SPI clocks
-            waitTXcomplete();
-            buffer[idx++] = SPDR;   // store result
-        }
+        readBulk(buffer, size);
 
         if (nullptr != m_slaveSelect) 
         {
@@ -194,16 +211,51 @@ namespace hal
             m_slaveSelect(true);
         }
 
-        for (uint16_t idx(0u); 0u != size; --size)
+        writeBulk(buffer, size);
+
+        if (nullptr != m_slaveSelect) 
         {
-            SPDR = buffer[idx++];    // send next byte
+            m_slaveSelect(false);
+        }
+    }
+
+    void Spi::writeBulk(const uint8_t buffer[], uint16_t size)
+    {
+        if (0u == size)
+        {
+            return;
+        }
+
+        const uint8_t * end(buffer + size);
+
+        SPDR = *buffer++;
+        while (buffer != end)
+        {
+            uint8_t next(*buffer++);    // fetch while current byte shifts
             waitTXcomplete();
+            SPDR = next;
         }
+        waitTXcomplete();
+    }
 
-        if (nullptr != m_slaveSelect) 
+    void Spi::readBulk(uint8_t buffer[], uint16_t size)
+    {
+        if (0u == size)
         {
-            m_slaveSelect(false);
+            return;
         }
+
+        uint8_t * last(buffer + size - 1u);
+
+        SPDR = 0xFF;                    // dummy write to generate SPI clocks
+        while (buffer != last)
+        {
+            waitTXcomplete();
+            SPDR = 0xFF;                // start next byte, then fetch the
+            *buffer++ = SPDR;           // previous one from receive buffer
+        }
+        waitTXcomplete();
+        *buffer = SPDR;
     }
 
     void Spi::write_P(const uint8_t buffer[], uint16_t size)
@@ -229,6 +281,32 @@ namespace hal
         }
     }
 
+    void Spi::writeRepeat(uint8_t value, uint32_t count)
+    {
+        if (0u == count)
+        {
+            return;
+        }
+
+        if (nullptr != m_slaveSelect) 
+        {
+            m_slaveSelect(true);
+        }
+
+        SPDR = value;
+        while (0u != --count)
+        {
+            waitTXcomplete();
+            SPDR = value;           // send next byte
+        }
+        waitTXcomplete();
+
+        if (nullptr != m_slaveSelect) 
+        {
+            m_slaveSelect(false);
+        }
+    }
+
     void Spi::exchange(uint8_t buffer[], uint16_t size)
     {
         if (nullptr != m_slaveSelect) 
@@ -34,6 +34,7 @@
 #define SPI_H_INCLUDED
 
 #include <stdint.h>
+#include <avr/io.h>
 
 namespace hal
 {
@@ -75,7 +76,9 @@ namespace hal
             {
                 CLK_250000,         /* 250kHz = use for SDCard init */
                 CLK_100000,         /* 1Mhz clock */
-                CLK_2000000         /* 2Mhz fast clock */
+                CLK_2000000,        /* 2Mhz fast clock */
+                CLK_4000000,        /* fosc/2, 4Mhz at Cpu::CLK_FAST */
+                CLK_COUNT           /* number of clock speeds */
             };
 
             /** Initialize SPI hardware
@@ -121,6 +124,14 @@ namespace hal
              */
             static void write_P(const uint8_t buffer[], uint16_t size);
 
+            /** Write the same byte repeatedly to SPI (ignoring received data)
+             *
+             *  The slave stays selected for the whole sequence.
+             *  @param[in] value byte to send
+             *  @param[in] count number of times to send value
+             */
+            static void writeRepeat(uint8_t value, uint32_t count);
+
             /** Exchange bytes over SPI
              * 
              *  Buffer gets filled with received bytes while sending
@@ -129,6 +140,42 @@ namespace hal
              */
             static void exchange(uint8_t buffer[], uint16_t size);
 
+            /** Write a block of bytes as fast as possible
+             *
+             *  The next byte is fetched while the current one shifts
+             *  out, so SPDR gets reloaded right after SPIF. Unlike
+             *  write() this does not call the slave select function.
+             *  @param[in] buffer data to send
+             *  @param[in] size number of bytes to send
+             */
+            static void writeBulk(const uint8_t buffer[], uint16_t size);
+
+            /** Read a block of bytes as fast as possible (sending 0xFF)
+             *
+             *  The next transfer starts before the received byte is
+             *  stored, using the receive buffer of the SPI. Unlike read()
+             *  this does not call the slave select function.
+             *  @param[out] buffer received data
+             *  @param[in] size number of bytes to store in buffer
+             */
+            static void readBulk(uint8_t buffer[], uint16_t size);
+
+            /** Exchange a single byte over SPI
+             *
+             *  Unlike the block functions this does not call the slave
+             *  select function. The caller is in charge of chip selects.
+             *  @param[in] value byte to send
+             *  @return received byte
+             */
+            inline static uint8_t transfer(uint8_t value)
+            {
+                SPDR = value;
+                while (0u == (SPSR & _BV(SPIF)))
+                {
+                }
+                return SPDR;
+            }
+
         private:
             static SlaveSelect m_slaveSelect;  /**< slave selection function */
 
@@ -31,6 +31,7 @@
  */
 
 #include "hal/Timer/TickTimer.h"
+#include "hal/Cpu/Cpu.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <avr/power.h>
@@ -46,6 +47,26 @@ static hal::TickTimer::TickFunctionCB tickCallback = nullptr;
 /** milliseconds since power on */
 static volatile uint32_t g_millies = 0u;
 
+/** Clock select bits of TCCR0B for the current CPU clock
+ *
+ * @return uint8_t clk/1024 at 8 Mhz, clk/256 otherwise
+ */
+static inline uint8_t clockSelect(void)
+{
+    return (hal::Cpu::CLK_FAST == hal::Cpu::getClock()) ?
+        ((1 << CS02) | (0 << CS01) | (1 << CS00)) :
+        ((1 << CS02) | (0 << CS01) | (0 << CS00));
+}
+
+/** Compare value of a 10ms tick for the current CPU clock
+ *
+ * @return uint8_t 78 at 8 Mhz (clk/1024), 156 otherwise (clk/256)
+ */
+static inline uint8_t tickCompare(void)
+{
+    return (hal::Cpu::CLK_FAST == hal::Cpu::getClock()) ? 78u : 156u;
+}
+
 /*******************************************************************************
     Implementation
 *******************************************************************************/
@@ -69,10 +90,10 @@ namespace hal
     void TickTimer::enable(TickTimer::TickFunctionCB callback)
     {        
         TCNT0 = 0u;
-        OCR0A = 156u;
+        OCR0A = tickCompare();
         OCR0B = 159u;
 
-        TCCR0B |= ((1 << CS02) | (0 << CS01) |(0 << CS00));   /* clk/256  */ 
+        TCCR0B |= clockSelect();   /* clk/256 (clk/1024 at 8 Mhz) */
 
         tickCallback = callback;
         TIMSK0 |= _BV(OCIE0A);     /* enable match OCRA interrupt */
@@ -86,6 +107,15 @@ namespace hal
         power_timer0_disable();
     }
 
+    void TickTimer::updateClock()
+    {
+        if (0u != (TIMSK0 & _BV(OCIE0A)))
+        {
+            TCCR0B = (uint8_t)((TCCR0B & ~((1 << CS02) | (1 << CS01) | (1 << CS00))) |
+                clockSelect());
+        }
+    }
+
     uint8_t TickTimer::getTickCount(void)
     {
         return GPIOR0;
@@ -120,7 +150,14 @@ ISR(TIMER0_COMPA_vect)
 
     uint8_t fastTickCnt(GPIOR0++);
 
-    OCR0A = (fastTickCnt % 4) ? 156u : 157u;    /* 10mhz is precisely 156.25 ticks */
+    if (hal::Cpu::CLK_FAST == hal::Cpu::getClock())
+    {
+        OCR0A = (fastTickCnt % 8) ? 78u : 79u;  /* 10ms is 78.125 ticks at 8 Mhz */
+    }
+    else
+    {
+        OCR0A = (fastTickCnt % 4) ? 156u : 157u;    /* 10mhz is precisely 156.25 ticks */
+    }
 
     g_millies += 10u;
 
@@ -67,6 +67,12 @@ namespace hal
              */
             static void disable();
 
+            /** Adapt the running timer to a new CPU clock
+             *
+             * @see Cpu::setClock
+             */
+            static void updateClock();
+
             /**
              * @brief Get the current number of passed ticks 
              * 
@@ -39,6 +39,60 @@
     Module statics
 *******************************************************************************/
 
+/** Timer 2 clock select bits, prescale 1024 */
+static const uint8_t CLOCK_SELECT = _BV(CS22) | _BV(CS21) | _BV(CS20);
+
+/** number of timer overflows since enable() */
+static volatile uint32_t g_overflows = 0ul;
+
+/** timer count (overflows * 256 + TCNT2) of the alarm */
+static volatile uint32_t g_alarmAt = 0ul;
+
+/** alarm time passed */
+static volatile bool g_alarm = true;
+
+/**
+ * @brief Wait until TCNT2 reflects the asynchronous counter
+ *
+ * TCNT2 reads may return the pre-sleep value until the next
+ * asynchronous clock edge. Trigger a dummy register update and
+ * wait for it, see ATmega328P datasheet "Asynchronous Operation
+ * of Timer/Counter2".
+ */
+static void syncCounter(void)
+{
+    TCCR2A = TCCR2A;
+    while (ASSR & _BV(TCR2AUB))
+    {
+    }
+}
+
+/**
+ * @brief Arm the compare match for the alarm counts in this overflow
+ *
+ * Called with interrupts off, once the overflow count reached the
+ * alarm. The register update must complete before the CPU enters
+ * power save again, or the match gets lost.
+ */
+static void armCompare(void)
+{
+    const uint8_t count((uint8_t)g_alarmAt);
+
+    if (count <= TCNT2)
+    {
+        g_alarm = true;
+    }
+    else
+    {
+        OCR2A = count;
+        while (ASSR & _BV(OCR2AUB))
+        {
+        }
+        TIFR2 = _BV(OCF2A);      /* clear stale match only */
+        TIMSK2 |= _BV(OCIE2A);   /* enable match interrupt */
+    }
+}
+
 
 /*******************************************************************************
     Implementation
@@ -52,14 +106,20 @@ namespace hal
 
         ASSR |= _BV(AS2); /* asynchronous operation using 32.768kHz crystal */
         TCCR2A = 0u;  /* Normal operation, no waveform pin output */
-        TCCR2B &= ~(_BV(CS22) | _BV(CS21)  | _BV(CS20));  /* no clock, stopped */
+        TCCR2B &= ~CLOCK_SELECT;  /* no clock, stopped */
         TIMSK2 = 0u;  /* interrupts disabled */
     }
 
     void WakeUpTimer::enable()
     {
+        if (0u != (TCCR2B & CLOCK_SELECT))
+        {
+            return; /* running, keep counting */
+        }
+
         TCNT2 = 0u;
-        TCCR2B |= _BV(CS22) | _BV(CS21)  | _BV(CS20);  /* prescale 1024 */
+        g_overflows = 0ul;
+        TCCR2B |= CLOCK_SELECT;  /* prescale 1024 */
 
         /* wait for updates to settle, we are clocked asyncronously to CPU */
         while (ASSR & (_BV(TCN2UB)|_BV(OCR2AUB|_BV(OCR2BUB)|_BV(TCR2AUB)|_BV(TCR2BUB))))
@@ -73,10 +133,66 @@ namespace hal
     void WakeUpTimer::disable()
     {        
         TIMSK2 = 0u;   /* interrupts disabled */
-        TCCR2B &= ~(_BV(CS22) | _BV(CS21)  | _BV(CS20));  /* no clock, stopped */
+        TCCR2B &= ~CLOCK_SELECT;  /* no clock, stopped */
 
         power_timer2_disable();
     }
+
+    void WakeUpTimer::setAlarm(uint32_t ms)
+    {
+        /* 32 counts per second, ms * 32 / 1000 without overflow */
+        const uint32_t counts(
+            ((ms / 125u) << 2u) + (((ms % 125u) << 2u) / 125u));
+
+        const uint8_t sreg(SREG);
+        cli();
+
+        const uint32_t now(getCounts());
+
+        TIMSK2 &= ~_BV(OCIE2A);
+        g_alarm = false;
+        g_alarmAt = now + counts;
+
+        if ((g_alarmAt >> 8u) == (now >> 8u))
+        {
+            armCompare();
+        }
+
+        SREG = sreg;
+    }
+
+    bool WakeUpTimer::isAlarm(void)
+    {
+        return g_alarm;
+    }
+
+    uint32_t WakeUpTimer::getCounts()
+    {
+        syncCounter();
+
+        const uint8_t sreg(SREG);
+        cli();
+
+        uint32_t overflows(g_overflows);
+        const uint8_t count(TCNT2);
+
+        if ((TIFR2 & _BV(TOV2)) && (count < 0x80u))
+        {
+            ++overflows; /* wrapped, but interrupt not handled yet */
+        }
+
+        SREG = sreg;
+
+        return (overflows << 8u) | count;
+    }
+
+    uint32_t WakeUpTimer::getElapsed_ms()
+    {
+        const uint32_t counts(getCounts());
+
+        /* 1000 / 32 = 125 / 4 ms per count */
+        return ((counts >> 2u) * 125u) + (((counts & 3u) * 125u) >> 2u);
+    }
 }
 
 /** overflow tick interrupt handler, expected every WAKEUP_INTERVAl_MS
@@ -88,8 +204,24 @@ ISR(TIMER2_OVF_vect)
      * Cpu need to wait here because timer is clocked asynchronously 
      * and registers update on the external clock ticks.
      */
-    TCCR2A = TCCR2A;
-    while (ASSR & _BV(TCR2AUB))
+    syncCounter();
+
+    ++g_overflows;
+
+    if ((!g_alarm) && ((g_alarmAt >> 8u) == g_overflows))
     {
+        armCompare();
     }
+}
+
+/** compare match handler, ends the alarm period after the last overflow
+ */
+ISR(TIMER2_COMPA_vect)
+{
+    TIMSK2 &= ~_BV(OCIE2A);
+
+    /* same dummy update as in the overflow handler */
+    syncCounter();
+
+    g_alarm = true;
 }
\ No newline at end of file
@@ -39,6 +39,9 @@ namespace hal
 {
     /** Timer 2  Driver for AVR 328P power safe wakeup
      * 
+     * Once enabled, the timer keeps running in sleep and awake phases
+     * and serves as time base for the real time clock.
+     *
      * Code assumes CPU clock divider as max (256), @see Cpu::setClock
      */ 
     class WakeUpTimer 
@@ -57,14 +60,57 @@ namespace hal
              */
             static void init();
 
-            /** Enable timer
+            /** Timer counts per second */
+            static const uint8_t COUNTS_PER_SECOND = 32u;
+
+            /** Enable timer, does nothing if it runs already
              */
             static void enable();
 
-            /** Disable timer
+            /** Disable timer, the time base stops
              */
             static void disable();
 
+            /**
+             * @brief Get the timer counts since the timer got enabled
+             *
+             * Counts at COUNTS_PER_SECOND, wraps after ~4 years.
+             * Callable with interrupts disabled.
+             *
+             * @return uint32_t counts
+             */
+            static uint32_t getCounts();
+
+            /**
+             * @brief Get the time since the timer got enabled
+             *
+             * Resolution is one timer count (31.25ms). Wraps after
+             * ~49 days, use differences.
+             *
+             * @return uint32_t elapsed milliseconds
+             */
+            static uint32_t getElapsed_ms();
+
+            /**
+             * @brief Program an alarm the given time from now
+             *
+             * Whole WAKEUP_INTERVAl_MS periods get counted down inside
+             * the overflow interrupt, the remainder is done by a compare
+             * match on the running counter. Resolution is one timer
+             * count (31.25ms). Requires an enabled timer.
+             *
+             * @param ms time until the alarm, 0 for an expired alarm
+             */
+            static void setAlarm(uint32_t ms);
+
+            /**
+             * @brief Check if the alarm time passed
+             *
+             * @return true  alarm expired
+             * @return false alarm pending
+             */
+            static bool isAlarm(void);
+
         private:
             WakeUpTimer(const WakeUpTimer&);
             WakeUpTimer& operator=(const WakeUpTimer&);
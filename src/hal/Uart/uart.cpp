@@ -30,6 +30,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "Uart.h"
+#include "hal/Cpu/Cpu.h"
 
 #include <avr/io.h>
 #include <avr/pgmspace.h>
@@ -255,8 +256,17 @@ namespace hal
 
         /* Shoot! (B last, it enables UART RX/TX)... 
          */
-        UBRR0H = pgm_read_byte(&regBaudrate[cfg.m_baudRate].high);
-        UBRR0L = pgm_read_byte(&regBaudrate[cfg.m_baudRate].low);
+        uint16_t ubrr(
+            (uint16_t)(pgm_read_byte(&regBaudrate[cfg.m_baudRate].high) << 8) |
+            pgm_read_byte(&regBaudrate[cfg.m_baudRate].low));
+
+        if (Cpu::CLK_FAST == Cpu::getClock())
+        {
+            ubrr = (uint16_t)(ubrr * 2u + 1u);  /* table is for F_CPU */
+        }
+
+        UBRR0H = (uint8_t)(ubrr >> 8);
+        UBRR0L = (uint8_t)ubrr;
         UCSR0A = localUCSR0A;
         UCSR0C = localUCSR0C;
         UCSR0B = localUCSR0B;
@@ -358,6 +368,8 @@ namespace hal
     } 
 }
 
+#if WITH_USART_DISPLAY == 0 /* USART0 used as display SPI otherwise */
+
 /** Interrupt entry for USART data register empty */
 ISR(USART_UDRE_vect)
 {
@@ -387,4 +399,6 @@ ISR(USART_RX_vect)
 
 }
 
+#endif /* WITH_USART_DISPLAY */
+
 /* EOF */
\ No newline at end of file
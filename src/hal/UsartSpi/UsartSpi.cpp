@@ -0,0 +1,352 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hal/UsartSpi/UsartSpi.h"
+#include "hal/Cpu/Cpu.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/power.h>
+
+#if WITH_USART_DISPLAY != 0
+
+#if WITH_DEBUG != 0
+#error WITH_USART_DISPLAY needs USART0, set WITH_DEBUG=0
+#endif
+
+#if BOARD_REVISION < 0x0300
+#error Boards up to revision 2.x use PD4 (XCK) as SD card chip select
+#endif
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/** Baud rate register values for Spi::ClockSpeeed per CPU clock
+ *  profile (normal, fast)
+ *
+ * MSPIM clock is fosc / (2 * (UBRR0 + 1))
+ */
+static const uint8_t g_ubrr[2][hal::Spi::CLK_COUNT] PROGMEM =
+{
+#if F_CPU == 1000000
+    {
+        1u,     /* CLK_250000                     */
+        0u,     /* CLK_1000000, 500kHz max        */
+        0u,     /* CLK_2000000, 500kHz max        */
+        0u,     /* CLK_4000000, 500kHz max        */
+    },
+    {
+        1u, 0u, 0u, 0u  /* no fast profile        */
+    }
+#elif F_CPU == 4000000
+    {
+        7u,     /* CLK_250000                     */
+        1u,     /* CLK_1000000                    */
+        0u,     /* CLK_2000000                    */
+        0u,     /* CLK_4000000, 2Mhz max          */
+    },
+    {   /* Cpu::CLK_FAST, 8 Mhz */
+        15u,    /* CLK_250000                     */
+        3u,     /* CLK_1000000                    */
+        1u,     /* CLK_2000000                    */
+        0u,     /* CLK_4000000                    */
+    }
+#else
+#error unsupported clock speed
+#endif
+};
+
+/** Baud rate register value for the current CPU clock
+ *
+ * @param clock SPI clock speed
+ * @return uint8_t UBRR0 value
+ */
+static inline uint8_t ubrr(hal::Spi::ClockSpeeed clock)
+{
+    return pgm_read_byte(&(g_ubrr[
+        (hal::Cpu::CLK_FAST == hal::Cpu::getClock()) ? 1u : 0u][clock]));
+}
+
+/** transmit buffers, one gets filled while the other is sent */
+static uint8_t g_buffer[2][hal::UsartSpi::BUFFER_SIZE];
+
+static uint8_t g_fill = 0u;                     /**< buffer being filled     */
+static uint8_t g_fillCount = 0u;                /**< bytes in fill buffer    */
+static const uint8_t * volatile g_txData;       /**< next byte to send (ISR) */
+static volatile uint8_t g_txCount = 0u;         /**< bytes left to send (ISR)*/
+static bool g_selected = false;                 /**< slave selected by queue */
+
+/** Send one byte as soon as the data register is free
+ */
+static inline void put(uint8_t value)
+{
+    while (0u == (UCSR0A & _BV(UDRE0)))
+    {
+    }
+    UDR0 = value;
+}
+
+/** Block until all bytes left the shift register
+ */
+static inline void waitTXcomplete()
+{
+    while (0u == (UCSR0A & _BV(TXC0)))
+    {
+    }
+}
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace hal
+{
+    Spi::SlaveSelect UsartSpi::m_slaveSelect;
+
+    void UsartSpi::init()
+    {
+        /* XCK (SCK) and TXD (MOSI) as outputs, high while idle
+         */
+        PORTD |= _BV(PD4) | _BV(PD1);
+        DDRD  |= _BV(PD4) | _BV(PD1);
+    }
+
+    void UsartSpi::enable()
+    {
+        power_usart0_enable();
+
+        m_slaveSelect = nullptr;
+        g_fillCount = 0u;
+        g_txCount = 0u;
+        g_selected = false;
+
+        /* baud rate must be zero while enabling the transmitter */
+        UBRR0  = 0u;
+        UCSR0C = _BV(UMSEL01) | _BV(UMSEL00);   /* master SPI, mode 0, MSB */
+        UCSR0B = _BV(TXEN0);                    /* transmit only           */
+        UBRR0  = ubrr(Spi::CLK_250000);
+    }
+
+    void UsartSpi::disable()
+    {
+        flush();
+
+        UCSR0B = 0u;
+
+        power_usart0_disable();
+    }
+
+    void UsartSpi::configure(
+            Spi::ClockSpeeed clock,
+            Spi::Mode mode,
+            Spi::BitOrder order,
+            Spi::SlaveSelect slaveSelect)
+    {
+        /* settings must not change while queued data is pending */
+        flush();
+
+        uint8_t localUCSR0C(_BV(UMSEL01) | _BV(UMSEL00));
+
+        if (Spi::BITORDER_LSB == order)
+        {
+            localUCSR0C |= _BV(UDORD0);
+        }
+
+        switch(mode)
+        {
+            case Spi::MODE_0:
+                break;
+
+            case Spi::MODE_1:
+                localUCSR0C |= _BV(UCPHA0);
+                break;
+
+            case Spi::MODE_2:
+                localUCSR0C |= _BV(UCPOL0);
+                break;
+
+            case Spi::MODE_3:
+                localUCSR0C |= _BV(UCPOL0) | _BV(UCPHA0);
+                break;
+        }
+
+        UCSR0C = localUCSR0C;
+        UBRR0  = ubrr(clock);
+
+        m_slaveSelect = slaveSelect;
+    }
+
+    void UsartSpi::write(const uint8_t buffer[], uint16_t size)
+    {
+        flush();
+        UCSR0A |= _BV(TXC0);    /* clear completion flag */
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(true);
+        }
+
+        for (uint16_t idx(0u); 0u != size; --size)
+        {
+            put(buffer[idx++]);
+        }
+        waitTXcomplete();
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(false);
+        }
+    }
+
+    void UsartSpi::write_P(const uint8_t buffer[], uint16_t size)
+    {
+        flush();
+        UCSR0A |= _BV(TXC0);    /* clear completion flag */
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(true);
+        }
+
+        for (uint16_t idx(0u); 0u != size; --size)
+        {
+            put(pgm_read_byte(&(buffer[idx++])));
+        }
+        waitTXcomplete();
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(false);
+        }
+    }
+
+    void UsartSpi::writeRepeat(uint8_t value, uint32_t count)
+    {
+        if (0u == count)
+        {
+            return;
+        }
+
+        flush();
+        UCSR0A |= _BV(TXC0);    /* clear completion flag */
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(true);
+        }
+
+        do
+        {
+            put(value);
+        } while (0u != --count);
+        waitTXcomplete();
+
+        if (nullptr != m_slaveSelect)
+        {
+            m_slaveSelect(false);
+        }
+    }
+
+    void UsartSpi::queue(uint8_t value)
+    {
+        g_buffer[g_fill][g_fillCount] = value;
+
+        if (BUFFER_SIZE == ++g_fillCount)
+        {
+            startTransmit();
+        }
+    }
+
+    void UsartSpi::flush()
+    {
+        if (0u != g_fillCount)
+        {
+            startTransmit();
+        }
+
+        while (0u != g_txCount)
+        {
+        }
+
+        if (g_selected)
+        {
+            waitTXcomplete();
+
+            if (nullptr != m_slaveSelect)
+            {
+                m_slaveSelect(false);
+            }
+            g_selected = false;
+        }
+    }
+
+    void UsartSpi::startTransmit()
+    {
+        /* wait for the interrupt to finish the other buffer */
+        while (0u != g_txCount)
+        {
+        }
+
+        if ((!g_selected) && (nullptr != m_slaveSelect))
+        {
+            m_slaveSelect(true);
+        }
+        g_selected = true;
+
+        g_txData = g_buffer[g_fill];
+        g_txCount = g_fillCount;
+
+        g_fill ^= 1u;
+        g_fillCount = 0u;
+
+        UCSR0A |= _BV(TXC0);     /* completion now depends on this buffer */
+        UCSR0B |= _BV(UDRIE0);   /* interrupt sends the buffer            */
+    }
+}
+
+/** Data register empty interrupt, sends the current transmit buffer
+ */
+ISR(USART_UDRE_vect)
+{
+    const uint8_t * data(g_txData);
+
+    UDR0 = *data++;
+    g_txData = data;
+
+    if (0u == --g_txCount)
+    {
+        UCSR0B &= ~(_BV(UDRIE0));
+    }
+}
+
+#endif /* WITH_USART_DISPLAY */
@@ -0,0 +1,129 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef USARTSPI_H_INCLUDED
+#define USARTSPI_H_INCLUDED
+
+#include <stdint.h>
+#include "hal/Spi/Spi.h"
+
+namespace hal
+{
+    /** USART0 in master SPI mode (MSPIM) as second SPI bus
+     *
+     * Pins: TXD (PD1) = MOSI, XCK (PD4) = SCK. No MISO, the bus is
+     * write only. Transfers on this bus can overlap with transfers on
+     * the SPI module.
+     *
+     * Besides blocking writes it offers a double buffered transmit:
+     * queue() fills one buffer while the USART data register empty
+     * interrupt sends the other.
+     *
+     * USART0 is not available for debug prints when using this driver.
+     */
+    class UsartSpi
+    {
+        public:
+
+            /** Size of each of the two transmit buffers */
+            static const uint8_t BUFFER_SIZE = 32u;
+
+            /** Initialize pins
+             */
+            static void init();
+
+            /** Enable USART in master SPI mode
+             */
+            static void enable();
+
+            /** Disable USART
+             */
+            static void disable();
+
+            /** Configure transfers
+             *  @param[in] clk clock spped  @see Spi::ClockSpeeed
+             *  @param[in] mode tansfer mode @see Spi::Mode
+             *  @param[in] order bit order in transmits
+             *  @param[in] slaveSelect slave select/deselect function
+             */
+            static void configure(
+                Spi::ClockSpeeed clkSpeed,
+                Spi::Mode mode,
+                Spi::BitOrder order,
+                Spi::SlaveSelect slaveSelect
+            );
+
+            /** Write bytes (blocking)
+             *  @param[in] buffer data to send
+             *  @param[in] size number of bytes to send
+             */
+            static void write(const uint8_t buffer[], uint16_t size);
+
+            /** Write bytes from program space (blocking)
+             *  @param[in] buffer data to send
+             *  @param[in] size number of bytes to send
+             */
+            static void write_P(const uint8_t buffer[], uint16_t size);
+
+            /** Write the same byte repeatedly (blocking)
+             *  @param[in] value byte to send
+             *  @param[in] count number of times to send value
+             */
+            static void writeRepeat(uint8_t value, uint32_t count);
+
+            /** Queue a byte for interrupt driven transmit
+             *
+             *  The slave gets selected with the first queued byte and
+             *  stays selected until flush(). Blocks only if both
+             *  buffers are in use.
+             *  @param[in] value byte to send
+             */
+            static void queue(uint8_t value);
+
+            /** Send all queued bytes and deselect the slave
+             */
+            static void flush();
+
+        private:
+            /** Hand the fill buffer to the transmit interrupt
+             */
+            static void startTransmit();
+
+            static Spi::SlaveSelect m_slaveSelect;  /**< slave selection function */
+
+        private:
+            UsartSpi(const UsartSpi&);
+            UsartSpi& operator=(const UsartSpi&);
+    };
+}
+
+#endif // USARTSPI_H_INCLUDED
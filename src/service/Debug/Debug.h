@@ -77,7 +77,7 @@ namespace service
 
 #else //defined(WITH_DEBUG)
 
-#define DEBUG_INIT() true
+#define DEBUG_INIT() do {} while (0)
 #define DEBUG_LOG(fmt, ...)
 #define DEBUG_LOGP(fmt, ...)
 #endif //defined(WITH_DEBUG)
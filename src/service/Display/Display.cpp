@@ -31,12 +31,21 @@
  */
 #include "hal/Gpio/Gpio.h"
 #include "hal/Spi/Spi.h"
+#include "hal/UsartSpi/UsartSpi.h"
 #include "hal/Cpu/Cpu.h"
 #include "service/Display/Display.h"
+#include "service/Display/PixelSource.h"
 #include "service/Debug/Debug.h"
+#include "service/Power/Power.h"
 
 namespace service
 {
+#if WITH_USART_DISPLAY != 0
+    typedef hal::UsartSpi DispSpi;  /**< display on its own SPI bus */
+#else
+    typedef hal::Spi DispSpi;       /**< display shares SPI with SD card */
+#endif
+
     /** Slave select function for SPI when talking to display
      * @see hal::SPi::configure
      */
@@ -143,6 +152,10 @@ namespace service
      */
     static const uint8_t RE3_cmdPWS[] PROGMEM = { 0xE3, 0xAA };
 
+    /** Upper limit for the display refresh duration (typical is ~12s)
+     */
+    static const uint16_t REFRESH_TIMEOUT_MS = 30000u;
+
     bool Epd::init(void)
     {
         bool result(false);
@@ -178,7 +191,7 @@ namespace service
     {
         /* first byte is command */
         hal::Gpio::clrDispDC();
-        hal::Spi::write_P(cmd, 1u);
+        DispSpi::write_P(cmd, 1u);
 
         /* cmd data bytes */
         if (1u < size)
@@ -186,7 +199,7 @@ namespace service
             hal::Gpio::setDispDC();  /* data bytes */
             ++cmd;
             --size;
-            hal::Spi::write_P(cmd, size);
+            DispSpi::write_P(cmd, size);
         }
     }
 
@@ -228,8 +241,8 @@ namespace service
 
     void Epd::configureSpi()
     {
-        hal::Spi::configure(
-            hal::Spi::CLK_2000000,
+        DispSpi::configure(
+            hal::Spi::CLK_4000000,
             hal::Spi::MODE_0,
             hal::Spi::BITORDER_MSB, dispSlaveSelect);
     }
@@ -247,7 +260,80 @@ namespace service
     {
         configureSpi();
 
-        hal::Spi::write(block, size);
+        DispSpi::write(block, size);
+    }
+
+    void Epd::streamByte(uint8_t twoPixel)
+    {
+#if WITH_USART_DISPLAY != 0
+        hal::UsartSpi::queue(twoPixel);
+#else
+        hal::Gpio::clrDispCS();
+        hal::Spi::transfer(twoPixel);
+        hal::Gpio::setDispCS();
+#endif
+    }
+
+    void Epd::streamRepeat(uint8_t twoPixel, uint16_t count)
+    {
+#if WITH_USART_DISPLAY != 0
+        do
+        {
+            hal::UsartSpi::queue(twoPixel);
+        } while (0u != --count);
+#else
+        hal::Gpio::clrDispCS();
+        do
+        {
+            hal::Spi::transfer(twoPixel);
+        } while (0u != --count);
+        hal::Gpio::setDispCS();
+#endif
+    }
+
+    void Epd::paint(PixelSource& source)
+    {
+        const uint16_t rowBytes(getWidth() >> 1u);
+        uint32_t left((uint32_t)rowBytes * getHeight());
+        uint32_t sent(0u);
+
+        beginPaint();
+
+        if (source.stream(sent))
+        {
+            left = (sent < left) ? (left - sent) : 0u;
+        }
+
+        uint16_t col((uint16_t)(sent % rowBytes));
+
+        while (0u != left)
+        {
+            uint16_t max(rowBytes - col);
+            uint8_t value;
+
+            if (max > left)
+            {
+                max = (uint16_t)left;
+            }
+
+            uint16_t count(source.next(value, max));
+
+            if (0u == count)
+            {
+                /* end of data, pad the row */
+                value = (uint8_t)((WHITE << 4) | WHITE);
+                count = max;
+            }
+
+            streamRepeat(value, count);
+
+            left -= count;
+            col += count;
+            if (rowBytes == col)
+            {
+                col = 0u;
+            }
+        }
     }
 
     void Epd::endPaint()
@@ -261,9 +347,19 @@ namespace service
         }
 
         sendCmd_P(R12_cmdDRF, sizeof(R12_cmdDRF)); // refresh
-        while(!waitForIdle(255u))
-        {
 
+        /* The refresh is the longest phase, sleep through it until
+         * the BUSYN pin change wakes us up.
+         */
+        hal::Cpu::enterIdle(1u);  /* give BUSYN time to go low */
+        if (!service::Power::sleepWhileDisplayBusy(REFRESH_TIMEOUT_MS))
+        {
+            /* the controller hangs, the module reset stops the refresh
+             * and turns the panel power off
+             */
+            DEBUG_LOGP("refresh timeout\r\n");
+            reset();
+            return;
         }
 
         sendCmd_P(R02_cmdPOF, sizeof(R02_cmdPOF));  // power off
@@ -284,25 +380,23 @@ namespace service
         hal::Cpu::enterIdle(20);
     }
 
-    void Epd::clear(Epd::Color color)
+    void Epd::fill(Epd::Color color)
     {
         configureSpi();
 
-        const uint8_t twoPixel((color<<4)|color);
-
-        uint16_t width(getWidth() >> 1u);
-        uint16_t height(getHeight());
+        /* each byte holds two pixel */
+        DispSpi::writeRepeat(
+            (uint8_t)((color << 4) | color),
+            (uint32_t)(getWidth() >> 1u) * getHeight());
+    }
 
+    void Epd::clear(Epd::Color color)
+    {
         /* There is no clear command, set every pixel to given color.
          */
-        beginPaint();
-
-        for(uint16_t i=0; i < width; i++) {
-            for(uint16_t j=0; j < height; j++) {
-                sendBlock(&twoPixel, 1);
-    		}
-    	}
+        SolidSource solid(color);
 
+        paint(solid);
         endPaint();
     }
 
@@ -37,6 +37,8 @@
 
 namespace service
 {
+    class PixelSource;
+
     /** Display driver for Waveshare EPD_5IN65F 7 Color E-Paper Display
      */
     class Epd
@@ -78,7 +80,40 @@ namespace service
          */
         static void sendBlock(const uint8_t * block, uint8_t size);
 
+        /** Send a single byte of pixel data to the display
+         *
+         *  Used as stream sink for data coming directly from the SD card.
+         *  Must be called between beginPaint() and endPaint(). The SPI
+         *  must already be configured like for the display (the SD card
+         *  driver uses identical settings for data transfers).
+         *  With WITH_USART_DISPLAY the display has its own bus. Bytes
+         *  are then queued and sent by interrupt while the SD card
+         *  delivers the next ones.
+         *  @param twoPixel byte holding 2 4Bit color values
+         */
+        static void streamByte(uint8_t twoPixel);
+
+        /** Send the same byte of pixel data repeatedly to the display
+         *
+         *  Stream counterpart to fill() with the same constraints as
+         *  streamByte().
+         *  @param twoPixel byte holding 2 4Bit color values
+         *  @param count number of times to send twoPixel (> 0)
+         */
+        static void streamRepeat(uint8_t twoPixel, uint16_t count);
+
+        /** Send a full frame from a pixel source
+         *
+         *  Starts painting and pulls the frame row by row from the
+         *  source, or lets the source send it directly if it supports
+         *  that. Missing data at the end is filled with WHITE. Call
+         *  endPaint() afterwards to show the frame.
+         *  @param source source of the frame pixel data
+         */
+        static void paint(PixelSource& source);
+
         /* Finish update
+         * A refresh that does not end in time resets the display module.
          */
         static void endPaint();
 
@@ -86,6 +121,12 @@ namespace service
          */
         static void sleep(void);
 
+        /** Send a full frame of the given color to the display
+         *  Must be called between beginPaint() and endPaint()
+         *  @param color color for all pixels
+         */
+        static void fill(Color color);
+
         /** Clear (fill) display with given color
          */
         static void clear(Color color);
@@ -0,0 +1,93 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Display/PixelSource.h"
+#include "service/Display/Display.h"
+
+namespace service
+{
+    SolidSource::SolidSource(uint8_t color) :
+        m_value((uint8_t)((color << 4) | color))
+    {
+    }
+
+    uint16_t SolidSource::next(uint8_t& value, uint16_t max)
+    {
+        value = m_value;
+        return max;
+    }
+
+    bool SolidSource::stream(uint32_t& sent)
+    {
+        Epd::fill((Epd::Color)(m_value & 0x0Fu));
+        sent = (uint32_t)(Epd::getWidth() >> 1u) * Epd::getHeight();
+
+        return true;
+    }
+
+    PatternSource::PatternSource(
+        uint16_t width,
+        uint8_t first, uint8_t second,
+        uint16_t stripe) :
+        m_rowBytes(width >> 1u),
+        m_stripe((stripe < 2u) ? 1u : (stripe >> 1u)),
+        m_col(0u),
+        m_first((uint8_t)((first << 4) | first)),
+        m_second((uint8_t)((second << 4) | second))
+    {
+    }
+
+    uint16_t PatternSource::next(uint8_t& value, uint16_t max)
+    {
+        const uint16_t stripe(m_col / m_stripe);
+        uint16_t run((stripe + 1u) * m_stripe - m_col);
+
+        if (run > m_rowBytes - m_col)
+        {
+            run = m_rowBytes - m_col;
+        }
+        if (run > max)
+        {
+            run = max;
+        }
+
+        value = (stripe & 1u) ? m_second : m_first;
+
+        m_col += run;
+        if (m_rowBytes == m_col)
+        {
+            m_col = 0u;
+        }
+
+        return run;
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PIXELSOURCE_H_INCLUDED
+#define PIXELSOURCE_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Source of display pixel data
+     *
+     * Epd::paint() pulls the frame row by row from a source. Sources
+     * return runs of identical bytes (2 pixel per byte), so repeated
+     * data needs no buffer. Sources can wrap other sources to decode
+     * or modify their data.
+     */
+    class PixelSource
+    {
+        public:
+
+            /**
+             * @brief Get the next run of pixel data
+             *
+             * @param[out] value byte holding 2 pixel
+             * @param max maximum run length, end of current row (> 0)
+             * @return uint16_t run length 1..max, 0 at end of data
+             */
+            virtual uint16_t next(uint8_t& value, uint16_t max) = 0;
+
+            /**
+             * @brief Send all data directly to the display
+             *
+             * Optional fast path for sources that can drive the display
+             * without going through next(), i.e. SD card streaming.
+             *
+             * @param[out] sent number of bytes sent
+             * @return true  data sent, next() is not used
+             * @return false not supported, use next()
+             */
+            virtual bool stream(uint32_t& sent)
+            {
+                (void)sent;
+                return false;
+            }
+
+        protected:
+            ~PixelSource() {}
+    };
+
+    /**
+     * @brief Source of a single color
+     */
+    class SolidSource : public PixelSource
+    {
+        public:
+            /**
+             * @param color color index for all pixel
+             */
+            explicit SolidSource(uint8_t color);
+
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+            virtual bool stream(uint32_t& sent) override;
+
+        private:
+            uint8_t m_value;    /**< byte with 2 pixel of color */
+    };
+
+    /**
+     * @brief Source of vertical stripes in two colors
+     */
+    class PatternSource : public PixelSource
+    {
+        public:
+            /**
+             * @param width  frame width in pixel
+             * @param first  color index of first stripe
+             * @param second color index of second stripe
+             * @param stripe stripe width in pixel (even, > 0)
+             */
+            PatternSource(
+                uint16_t width,
+                uint8_t first, uint8_t second,
+                uint16_t stripe);
+
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+
+        private:
+            uint16_t m_rowBytes;   /**< bytes per row                */
+            uint16_t m_stripe;     /**< bytes per stripe             */
+            uint16_t m_col;        /**< byte column in current row   */
+            uint8_t  m_first;      /**< byte of first stripe color   */
+            uint8_t  m_second;     /**< byte of second stripe color  */
+    };
+}
+
+#endif /* PIXELSOURCE_H_INCLUDED */
@@ -43,6 +43,7 @@
 #define CMD9	(9)			/* SEND_CSD */
 #define CMD10	(10)		/* SEND_CID */
 #define CMD12	(12)		/* STOP_TRANSMISSION */
+#define CMD13	(13)		/* SEND_STATUS */
 #define ACMD13	(0x80+13)	/* SD_STATUS (SDC) */
 #define CMD16	(16)		/* SET_BLOCKLEN */
 #define CMD17	(17)		/* READ_SINGLE_BLOCK */
@@ -70,6 +71,12 @@ BYTE Timer1, Timer2;	/* 100Hz decrement timer */
 static
 BYTE CardType;			/* Card type flags */
 
+static
+DSTREAM StreamFunc;		/* Stream sink for read data, NULL: read into buffer */
+
+static
+const BYTE* StreamKeep;	/* Buffer still filled in stream mode (FatFs window) */
+
 /*-----------------------------------------------------------------------*/
 /* Transmit/Receive data from/to MMC via SPI  (Platform dependent)       */
 /*-----------------------------------------------------------------------*/
@@ -80,8 +87,7 @@ BYTE xchg_spi (		/* Returns received data */
 	BYTE dat		/* Data to be sent */
 )
 {
-	hal::Spi::exchange(&dat, 1);
-	return dat;
+	return hal::Spi::transfer(dat);
 }
 
 /*-----------------------------------------------------------------------*/
@@ -160,7 +166,45 @@ int rcvr_datablock (
 	} while ((token == 0xFF) && Timer1);
 	if (token != 0xFE) return 0;	/* If not valid data token, retutn with error */
 
-	hal::Spi::read(buff, btr);		/* Receive the data block into buffer */
+	hal::Spi::readBulk(buff, btr);	/* Receive the data block into buffer */
+
+	xchg_spi(0xFF);					/* Discard CRC */
+	xchg_spi(0xFF);
+
+	return 1;						/* Return with success */
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Receive a data packet from MMC and pass it to the stream sink         */
+/*-----------------------------------------------------------------------*/
+
+static
+int rcvr_datastream (
+	DSTREAM func,		/* Sink to receive the data bytes */
+	UINT btr			/* Byte count */
+)
+{
+	BYTE token;
+
+
+	Timer1 = 20;
+	do {							/* Wait for data packet in timeout of 200ms */
+		token = xchg_spi(0xFF);
+	} while ((token == 0xFF) && Timer1);
+	if (token != 0xFE) return 0;	/* If not valid data token, retutn with error */
+
+	do {
+		token = xchg_spi(0xFF);		/* Receive a data byte */
+#if WITH_USART_DISPLAY != 0
+		func(token);				/* sink uses its own bus */
+#else
+		CS_HIGH();					/* Release the bus to the sink */
+		func(token);
+		CS_LOW();
+#endif
+	} while (--btr);
 
 	xchg_spi(0xFF);					/* Discard CRC */
 	xchg_spi(0xFF);
@@ -188,7 +232,7 @@ int xmit_datablock (
 
 	xchg_spi(token);					/* Xmit data token */
 	if (token != 0xFD) {	/* Is data token */
-		hal::Spi::write(buff, 512);		/* Xmit the data block to the MMC */
+		hal::Spi::writeBulk(buff, 512);	/* Xmit the data block to the MMC */
 		xchg_spi(0xFF);					/* CRC (Dummy) */
 		xchg_spi(0xFF);
 		resp = xchg_spi(0xFF);			/* Reveive data response */
@@ -330,6 +374,43 @@ DSTATUS disk_initialize (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Resume Disk Drive that stayed powered                                 */
+/*-----------------------------------------------------------------------*/
+/* A card that was initialized before and kept its supply only needs a   */
+/* single SEND_STATUS to check it is still in SPI transfer state. Any    */
+/* other answer (card swapped or power lost) runs the full init.         */
+
+DSTATUS disk_resume (
+	BYTE pdrv		/* Physical drive nmuber (0) */
+)
+{
+	if (pdrv) return STA_NOINIT;		/* Supports only single drive */
+
+	if (Stat & STA_NODISK) return Stat;	/* No card in the socket */
+
+	Stat |= STA_NOINIT;
+
+	if (CardType) {
+		hal::Spi::configure(
+			hal::Spi::CLK_4000000,
+			hal::Spi::MODE_0,
+			hal::Spi::BITORDER_MSB,
+			nullptr);
+
+		if (send_cmd(CMD13, 0) == 0 && xchg_spi(0xFF) == 0) {	/* R2: no error bits */
+			Stat &= ~STA_NOINIT;
+		}
+		deselect();
+	}
+
+	if (Stat & STA_NOINIT) return disk_initialize(pdrv);
+
+	return Stat;
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status                                                       */
 /*-----------------------------------------------------------------------*/
@@ -352,28 +433,35 @@ DRESULT disk_read (
 	BYTE pdrv,			/* Physical drive nmuber (0) */
 	BYTE *buff,			/* Pointer to the data buffer to store read data */
 	DWORD sector,		/* Start sector number (LBA) */
-	UINT count			/* Sector count (1..128) */
+	UINT count			/* Sector count (1..65535) */
 )
 {
-	BYTE cmd;
+	BYTE cmd, stream;
 
 
 	if (pdrv || !count) return RES_PARERR;
 	if (Stat & STA_NOINIT) return RES_NOTRDY;
 
 	hal::Spi::configure(
-		hal::Spi::CLK_2000000,
+		hal::Spi::CLK_4000000,
 		hal::Spi::MODE_0, 
 		hal::Spi::BITORDER_MSB, 
 		nullptr);
 
 	if (!(CardType & CT_BLOCK)) sector *= 512;	/* Convert to byte address if needed */
 
+	/* Decide once, buff is not advanced in stream mode (no RAM behind it) */
+	stream = (StreamFunc && buff != StreamKeep) ? 1 : 0;
+
 	cmd = count > 1 ? CMD18 : CMD17;			/*  READ_MULTIPLE_BLOCK : READ_SINGLE_BLOCK */
 	if (send_cmd(cmd, sector) == 0) {
 		do {
-			if (!rcvr_datablock(buff, 512)) break;
-			buff += 512;
+			if (stream) {
+				if (!rcvr_datastream(StreamFunc, 512)) break;
+			} else {
+				if (!rcvr_datablock(buff, 512)) break;
+				buff += 512;
+			}
 		} while (--count);
 		if (cmd == CMD18) send_cmd(CMD12, 0);	/* STOP_TRANSMISSION */
 	}
@@ -384,6 +472,26 @@ DRESULT disk_read (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Configure Stream Mode for disk_read()                                 */
+/*-----------------------------------------------------------------------*/
+/* In stream mode each received byte gets passed to func instead of the  */
+/* read buffer. The card is deselected during the call, so func may use  */
+/* the SPI bus for another slave with the same SPI settings. Reads into  */
+/* the keep buffer (FatFs window for FAT/directory access) still land in */
+/* RAM.                                                                  */
+
+void disk_stream (
+	DSTREAM func,		/* Stream sink, NULL to leave stream mode */
+	const BYTE* keep	/* Buffer to keep filling in stream mode */
+)
+{
+	StreamFunc = func;
+	StreamKeep = keep;
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Write Sector(s)                                                       */
 /*-----------------------------------------------------------------------*/
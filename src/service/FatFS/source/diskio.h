@@ -27,11 +27,16 @@ typedef enum {
 
 
 DSTATUS disk_initialize (BYTE pdrv);
+DSTATUS disk_resume (BYTE pdrv);
 DSTATUS disk_status (BYTE pdrv);
 DRESULT disk_read (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+/* Sink receiving sector data bytes in stream mode */
+typedef void (*DSTREAM)(BYTE dat);
+void disk_stream (DSTREAM func, const BYTE* keep);
+
 
 /* Disk Status Bits (DSTATUS) */
 
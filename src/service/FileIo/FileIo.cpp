@@ -33,10 +33,19 @@
 #include "service/FileIo/FileIo.h"
 
 #include "service/Power/Power.h"
+#include "service/Resume/Resume.h"
+#include "service/Shuffle/Shuffle.h"
 #include "service/Debug/Debug.h"
+#include "service/Stats/Stats.h"
+#include "service/Crc/Crc.h"
 #include "service/FatFS/source/ff.h"
 #include "service/FatFS/source/diskio.h"
 
+#include <string.h>
+#if WITH_MOUNT_CACHE != 0
+#include <stddef.h>
+#endif
+
 /**
  * @brief Internal state of file system access
  *
@@ -59,10 +68,235 @@ static FATFS    g_fs;     /**< file system information for FatFS */
 static DIR      g_dir;    /**< directory information for FatFS   */
 static FILINFO  g_fno;    /**< directory fíle info for FatFS     */
 static FIL      g_fil;    /**< open file handle                  */
+static FIL      g_baseFil;/**< base image of a window image      */
+static bool     g_baseOpen; /**< g_baseFil is open                */
 static bool     g_enable; /**< true if enabled                   */
+static uint32_t g_vsn;    /**< volume serial number, 0 = unknown */
+static uint16_t g_scanPos;/**< position of the image in the scan  */
+static service::Shuffle g_shuffle; /**< random order, 0 = off    */
+static bool     g_shuffleOn; /**< random order selected           */
+
+/**
+ * @brief Directory position of the current image in an album
+ */
+struct AlbumPos
+{
+    uint32_t dptr;      /**< directory offset, 0 = first image */
+    uint32_t cluster;   /**< directory cluster at dptr         */
+    uint32_t sector;    /**< directory sector at dptr          */
+    uint32_t dirClust;  /**< directory start cluster of count  */
+    uint16_t index;     /**< image position                    */
+    uint16_t count;     /**< number of images, 0 = not counted */
+};
+
+static AlbumPos g_albumPos[service::FileIo::MAX_ALBUMS]; /**< per album */
+static uint8_t  g_album;  /**< current album                     */
+static char     g_albumName[service::FileIo::ALBUM_NAME_MAX + 1u] = "img";
+
+#if FF_USE_FASTSEEK
+/** fragments the cluster link map can hold */
+static const uint8_t CLMT_FRAGMENTS = 4u;
+
+/** cluster link map of the open file: size, (length, start cluster)
+ *  per fragment, terminator
+ */
+static DWORD g_clmt[2u * CLMT_FRAGMENTS + 2u];
+#endif
+
+#if WITH_SD_STREAMING != 0
+/** largest sector multiple f_read() can stream in one call */
+static const UINT g_streamMax = (UINT)~0u & ~(UINT)(FF_MAX_SS - 1u);
+#endif
 
 static const char g_fnPattern[] = "*.epd";
-static const char g_dirPath[] = "/epd/img";
+static const char g_epdPath[] = "/epd/";
+static const char g_defaultAlbum[] = "img";
+
+/** Buffer size for paths built by albumPath() */
+static const uint8_t ALBUM_PATH_MAX =
+    sizeof(g_epdPath) + service::FileIo::ALBUM_NAME_MAX + 4u;
+
+/** Build a path from the current album name
+ *
+ * @param[out] path  buffer of ALBUM_PATH_MAX characters
+ * @param suffix     appended to /epd/<album>, at most 4 characters
+ */
+static void albumPath(char * path, const char * suffix)
+{
+    strcpy(path, g_epdPath);
+    strcat(path, g_albumName);
+    strcat(path, suffix);
+}
+
+#if WITH_MOUNT_CACHE != 0
+/**
+ * @brief FAT geometry of the last mounted volume
+ *
+ * Kept in uninitialized RAM, so it survives Power::reboot() but not a
+ * power loss. The crc8 detects random content after power on.
+ */
+struct MountCache
+{
+    uint32_t vsn;           /**< volume serial number              */
+    LBA_t    volbase;       /**< volume base sector                */
+    LBA_t    fatbase;       /**< FAT base sector                   */
+    LBA_t    dirbase;       /**< root directory sector/cluster     */
+    LBA_t    database;      /**< data base sector                  */
+    DWORD    n_fatent;      /**< number of FAT entries             */
+    DWORD    fsize;         /**< FAT size in sectors               */
+    WORD     n_rootdir;     /**< root directory entries (FAT12/16) */
+    WORD     csize;         /**< cluster size in sectors           */
+    BYTE     fs_type;       /**< FAT sub type                      */
+    BYTE     n_fats;        /**< number of FATs                    */
+    uint8_t  crc8;          /**< CRC8 over all members above       */
+};
+
+static MountCache g_mountCache __attribute__((section(".noinit")));
+#endif
+
+/** Mount the volume
+ *
+ * With a valid mount cache, the geometry is restored from it and
+ * only checked by reading the volume serial number from the boot
+ * sector. The card must be up from FileIo::enable(). Otherwise FatFS
+ * probes partition table and boot sector.
+ *
+ * @return FRESULT FR_OK if the volume is mounted
+ */
+static FRESULT mountVolume(void);
+
+/** Start directory scanning at the first image
+ *
+ * @return true  image found, status is FIO_READY
+ * @return false no image or error, status is FIO_ERROR
+ */
+static bool findFirst(void);
+
+/** Build the cluster link map of the open file
+ *
+ * With a map, reading follows the cluster chain without FAT sector
+ * reads, which would evict file data from the FF_FS_TINY window.
+ * Files with more fragments than the map holds are read without map.
+ *
+ * @return FRESULT FR_OK if the file is usable
+ */
+static FRESULT linkMap(void);
+
+#if WITH_SD_STREAMING != 0
+/** Get the sector at the file pointer if the open file is contiguous
+ *
+ * @param[out] sector LBA of the sector holding the file pointer
+ * @return true  file is a single fragment
+ * @return false fragmented or no link map
+ */
+static bool contiguousSector(LBA_t& sector);
+#endif
+
+/** Move directory scanning to an image position
+ *
+ * Counts matching entries forward from the current image, or from the
+ * first one if the position is behind. Restarts at the first image if
+ * the directory ends before.
+ *
+ * @param target image position
+ * @param[out] pos directory state in front of the image for Resume
+ * @return true  image found, status is FIO_READY
+ * @return false read error
+ */
+static bool seekScan(uint16_t target, service::Resume::Position& pos);
+
+/** Count the images in the directory
+ *
+ * The count is kept per album for the scanned directory, so albums
+ * switching on every wakeup don't scan it again.
+ *
+ * @return uint16_t number of images
+ */
+static uint16_t countImages(void);
+
+/** Set up the shuffle order for the current album
+ */
+static void beginShuffle(void);
+
+/** Seed for the shuffle order, the same for a card over resets
+ *
+ * @return uint16_t seed
+ */
+static inline uint16_t shuffleSeed(void)
+{
+    return (uint16_t)(g_vsn ^ (g_vsn >> 16u));
+}
+
+/** Continue directory scanning at a saved position
+ *
+ * The saved directory sector must fit to its cluster and offset,
+ * otherwise scanning restarts at the first image.
+ *
+ * @param pos saved position
+ * @return true  image found, status is FIO_READY
+ * @return false no image or error
+ */
+static bool resumeScan(const service::Resume::Position& pos);
+
+#if WITH_IMAGE_INDEX != 0
+/**
+ * @brief Image index file header (little endian)
+ */
+struct IndexHeader
+{
+    uint8_t  signature[4];  /**< 'E' 'P' 'D' 'I'               */
+    uint8_t  version;       /**< index version (2)             */
+    uint8_t  reserved;      /**< set to 0                      */
+    uint16_t count;         /**< number of entries             */
+    uint16_t files;         /**< *.epd files in the directory  */
+};
+
+/**
+ * @brief Image index file entry (little endian)
+ */
+struct IndexEntry
+{
+    char     name[12];      /**< 8.3 file name, 0 padded       */
+    uint32_t cluster;       /**< start cluster                 */
+    uint32_t size;          /**< file size in bytes            */
+};
+
+static const char g_idxSuffix[] = ".idx";
+static const uint8_t g_idxSignature[] = { 'E', 'P', 'D', 'I' };
+static const uint8_t g_idxVersion = 2u;
+
+static uint16_t g_idxCount;   /**< index entries, 0 = scan directory */
+static uint16_t g_idxPos;     /**< current index entry               */
+static DWORD    g_idxCluster; /**< start cluster of current image    */
+
+/** Load the image index file and select an entry
+ *
+ * The index is stale if the album directory holds another number of
+ * images than when it was made, i.e. images got copied afterwards.
+ *
+ * @param pos entry to select, first one if out of range
+ * @return true  index is used
+ * @return false no usable index, scan directory
+ */
+static bool loadIndex(uint16_t pos);
+
+/** Select an index entry as current image
+ *
+ * @param pos entry number
+ * @return true  entry selected
+ * @return false read error or invalid entry
+ */
+static bool readIndexEntry(uint16_t pos);
+
+/** Open the current image by its start cluster
+ *
+ * Skips the directory lookup of f_open(). Walks the cluster chain
+ * once to detect a stale index.
+ *
+ * @return FRESULT FR_OK if the file is open
+ */
+static FRESULT openIndexed(void);
+#endif
 
 /*******************************************************************************
     Implementation
@@ -73,34 +307,112 @@ namespace service
 
     bool FileIo::init(void)
     {
-        FRESULT res(f_mount(&g_fs, "", 1));
+        FRESULT res(mountVolume());
 
         DEBUG_LOGP("FileIo f_mount-> %d\r\n", res);
 
         if (FR_OK == res)
         {
-           g_status = FIO_MOUNT;
+            g_status = FIO_MOUNT;
 
-            /* expect data in epd directory */
-            res = f_chdir(g_dirPath);
-            DEBUG_LOGP("FileIo f_chdir-> %d\r\n", res);
+            /* continue where we stopped if it is the same card */
+            Resume::Position pos;
 
-            if (FR_OK == res)
+            if (!getVolumeSerialNumber(g_vsn))
             {
-                /* start to search for *.epd in /epd  directory
-                 */
-                res = f_findfirst(&g_dir, &g_fno, g_dirPath, g_fnPattern);
-                DEBUG_LOGP("FileIo f_findfirst-> %d\r\n", res);
-                if ((FR_OK == res) && (0 != g_fno.fname[0]))
-                {
-                    g_status = FIO_READY;
-                }
+                g_vsn = 0u;
+            }
+
+            if (Resume::load(pos) && (0u != g_vsn) && (g_vsn == pos.vsn) &&
+                (MAX_ALBUMS > pos.album))
+            {
+                g_album = pos.album;
+                g_albumPos[g_album].dptr = pos.dptr;
+                g_albumPos[g_album].cluster = pos.cluster;
+                g_albumPos[g_album].sector = pos.sector;
+                g_albumPos[g_album].index = pos.index;
             }
         }
 
+        return FIO_MOUNT == g_status;
+    }
+
+    bool FileIo::setAlbum(uint8_t album, const char * name)
+    {
+        if ((MAX_ALBUMS <= album) ||
+            ((FIO_MOUNT != g_status) && (FIO_READY != g_status)))
+        {
+            return false;
+        }
+
+        if (nullptr == name)
+        {
+            name = g_defaultAlbum;
+        }
+
+        if ((FIO_READY == g_status) && (album == g_album) &&
+            (0 == strncmp(name, g_albumName, ALBUM_NAME_MAX)))
+        {
+            return true;
+        }
+
+        if (FIO_READY == g_status)
+        {
+            f_closedir(&g_dir);
+        }
+        g_status = FIO_MOUNT;
+        g_fno.fname[0] = '\0';
+
+        g_album = album;
+        strncpy(g_albumName, name, ALBUM_NAME_MAX);
+        g_albumName[ALBUM_NAME_MAX] = '\0';
+
+        /* expect images in the album directory */
+        char path[ALBUM_PATH_MAX];
+        albumPath(path, "");
+
+        FRESULT res(f_chdir(path));
+        DEBUG_LOGP("FileIo album %u %s -> %d\r\n", album, path, res);
+
+        if (FR_OK != res)
+        {
+            return false;
+        }
+
+        Resume::Position pos;
+        pos.vsn = g_vsn;
+        pos.album = album;
+        pos.dptr = g_albumPos[album].dptr;
+        pos.cluster = g_albumPos[album].cluster;
+        pos.sector = g_albumPos[album].sector;
+        pos.index = g_albumPos[album].index;
+
+#if WITH_IMAGE_INDEX != 0
+        if (loadIndex(pos.index))
+        {
+            g_status = FIO_READY;
+        }
+        else
+#endif
+        {
+            /* start to search for *.epd in the album directory
+             */
+            if (findFirst() && (0u != pos.dptr))
+            {
+                (void)resumeScan(pos);
+            }
+        }
+
+        beginShuffle();
+
         return FIO_READY == g_status;
     }
 
+    uint8_t FileIo::getAlbum(void)
+    {
+        return g_album;
+    }
+
     bool FileIo::next()
     {
         if (false == g_enable)
@@ -115,36 +427,71 @@ namespace service
             return false;
         }
 
-        FRESULT res(f_findnext(&g_dir, &g_fno));
-        DEBUG_LOGP("FileIo f_findnext-> %d\r\n", res);
+        /* position to continue from after a reset */
+        Resume::Position pos;
 
-        if (FR_OK != res)
-        {
-            g_status = FIO_ERROR;
-            return false;
-        }
+        pos.vsn = g_vsn;
+        pos.album = g_album;
+        pos.index = 0u;
+        pos.dptr = g_dir.dptr;
+        pos.cluster = g_dir.clust;
+        pos.sector = g_dir.sect;
 
-        if (0 == g_fno.fname[0])
+#if WITH_IMAGE_INDEX != 0
+        if (0u != g_idxCount)
         {
-            /* reached end of entries, restart */
-            f_closedir(&g_dir);
+            const uint16_t target((0u != g_shuffle.getCount()) ?
+                g_shuffle.next(g_idxPos) :
+                (uint16_t)((g_idxPos + 1u) % g_idxCount));
 
-            res = f_findfirst(&g_dir, &g_fno, g_dirPath, g_fnPattern);
-            DEBUG_LOGP("FileIo f_findfirst-> %d\r\n", res);
-            if ((FR_OK == res) && (0 != g_fno.fname[0]))
+            if (readIndexEntry(target))
             {
-                g_status = FIO_READY;
+                pos.index = g_idxPos;
+                pos.dptr = 0u;
+                g_albumPos[g_album].dptr = 0u;
+                g_albumPos[g_album].index = g_idxPos;
+                Resume::save(pos);
+
+                return true;
             }
-            else
+
+            DEBUG_LOGP("FileIo index stale\r\n");
+            g_idxCount = 0u;
+
+            if (!findFirst())
             {
-                g_status = FIO_ERROR;
                 return false;
             }
+            beginShuffle();
+
+            return true;
+        }
+#endif
+
+        const uint16_t target((0u != g_shuffle.getCount()) ?
+            g_shuffle.next(g_scanPos) : (uint16_t)(g_scanPos + 1u));
+
+        if (!seekScan(target, pos))
+        {
+            return false;
         }
 
+        pos.index = g_scanPos;
+        g_albumPos[g_album].dptr = pos.dptr;
+        g_albumPos[g_album].cluster = pos.cluster;
+        g_albumPos[g_album].sector = pos.sector;
+        g_albumPos[g_album].index = pos.index;
+        Resume::save(pos);
+
         return true;
     }
 
+    void FileIo::setShuffle(bool enable)
+    {
+        g_shuffleOn = enable;
+        beginShuffle();
+    }
+
     const char * FileIo::getFileName()
     {
         return g_fno.fname;
@@ -152,10 +499,36 @@ namespace service
 
     bool FileIo::open(const char * fname)
     {
-        if (FIO_READY == g_status)
+        if ((FIO_READY == g_status) || (FIO_MOUNT == g_status))
         {
-            FRESULT res(f_open(&g_fil, fname, FA_READ));
-            DEBUG_LOGP("FileIo::f_open() -> %d\r\n", res);
+            FRESULT res;
+
+#if WITH_IMAGE_INDEX != 0
+            if ((FIO_READY == g_status) &&
+                (0u != g_idxCount) && (fname == g_fno.fname))
+            {
+                res = openIndexed();
+                DEBUG_LOGP("FileIo::openIndexed() -> %d\r\n", res);
+
+                if (FR_OK != res)
+                {
+                    /* skip this update, continue with directory scan */
+                    g_idxCount = 0u;
+                    (void)findFirst();
+                    return false;
+                }
+            }
+            else
+#endif
+            {
+                res = f_open(&g_fil, fname, FA_READ);
+                DEBUG_LOGP("FileIo::f_open() -> %d\r\n", res);
+
+                if (FR_OK == res)
+                {
+                    res = linkMap();
+                }
+            }
 
             if (FR_OK == res)
             {
@@ -170,19 +543,33 @@ namespace service
     {
         if (FIO_OPEN == g_status)
         {
+            if (g_baseOpen)
+            {
+                (void)f_close(&g_baseFil);
+                g_baseOpen = false;
+            }
+
             FRESULT res(f_close(&g_fil));
             DEBUG_LOGP("FileIo::f_close() -> %d\r\n", res);
-            /* expect data in epd directory */
-            res = f_chdir(g_dirPath);
-            DEBUG_LOGP("FileIo f_chdir-> %d\r\n", res);
+            g_status = FIO_MOUNT;
 
-            if (FR_OK == res)
+            if ('\0' != g_fno.fname[0])
             {
-                g_status = FIO_READY;
+                /* expect data in album directory */
+                char path[ALBUM_PATH_MAX];
+                albumPath(path, "");
+
+                res = f_chdir(path);
+                DEBUG_LOGP("FileIo f_chdir-> %d\r\n", res);
+
+                if (FR_OK == res)
+                {
+                    g_status = FIO_READY;
+                }
             }
         }
 
-        return FIO_READY == g_status;
+        return (FIO_READY == g_status) || (FIO_MOUNT == g_status);
     }
 
     bool FileIo::read(void * buf, uint16_t size, uint16_t& read)
@@ -208,13 +595,156 @@ namespace service
         return false;
     }
 
-    bool FileIo::enable()
+    uint32_t FileIo::getFileSize(void)
+    {
+        return (FIO_OPEN == g_status) ? (uint32_t)f_size(&g_fil) : 0u;
+    }
+
+    bool FileIo::openBase(const char * fname)
+    {
+        if ((FIO_OPEN != g_status) || g_baseOpen)
+        {
+            return false;
+        }
+
+        FRESULT res(f_open(&g_baseFil, fname, FA_READ));
+        DEBUG_LOGP("FileIo::openBase(%s) -> %d\r\n", fname, res);
+
+        g_baseOpen = (FR_OK == res);
+
+        return g_baseOpen;
+    }
+
+    bool FileIo::readBase(void * buf, uint16_t size, uint16_t& read)
+    {
+        read = 0u;
+
+        if (!g_baseOpen)
+        {
+            return false;
+        }
+
+        UINT retRead;
+        FRESULT res(f_read(&g_baseFil, buf, size, &retRead));
+
+        if (FR_OK == res)
+        {
+            read = (uint16_t)retRead;
+        }
+        else
+        {
+            DEBUG_LOGP("FileIo::readBase() -> %d\r\n", res);
+        }
+
+        return FR_OK == res;
+    }
+
+    bool FileIo::stream(FileIo::StreamSink sink, uint32_t& streamed)
+    {
+        FRESULT res(FR_OK);
+
+        streamed = 0u;
+
+        if (FIO_OPEN != g_status)
+        {
+            return false;
+        }
+
+        while (f_tell(&g_fil) < f_size(&g_fil))
+        {
+            FSIZE_t remain(f_size(&g_fil) - f_tell(&g_fil));
+            UINT offset((UINT)(f_tell(&g_fil) % FF_MAX_SS));
+            UINT retRead(0u);
+            FSIZE_t done(0u); /* bytes passed to the sink */
+
+#if WITH_SD_STREAMING != 0
+            LBA_t sector;
+
+            if ((0u == offset) && (FF_MAX_SS <= remain) &&
+                contiguousSector(sector))
+            {
+                /* Contiguous file: all whole sectors with a single
+                 * multi block read, f_read() would split it at every
+                 * cluster boundary.
+                 */
+                const FSIZE_t sectors(remain / FF_MAX_SS);
+                const UINT count(((FSIZE_t)(UINT)~0u < sectors) ?
+                    (UINT)~0u : (UINT)sectors);
+
+                DEBUG_LOGP("FileIo::stream() %lu+%u\r\n", sector, count);
+
+                disk_stream(sink, g_fs.win);
+                res = (RES_OK == disk_read(g_fs.pdrv, iobuf, sector, count)) ?
+                    FR_OK : FR_DISK_ERR;
+                disk_stream(nullptr, nullptr);
+
+                if (FR_OK == res)
+                {
+                    done = (FSIZE_t)count * FF_MAX_SS;
+                    res = f_lseek(&g_fil, f_tell(&g_fil) + done);
+                }
+            }
+            else if ((0u == offset) && (FF_MAX_SS <= remain))
+            {
+                /* Whole sectors: f_read() hands them directly to
+                 * disk_read(), which passes them to the sink instead of
+                 * the buffer. FAT lookups of fragmented files without
+                 * link map still go to the FatFS window.
+                 */
+                UINT size((remain < g_streamMax) ?
+                    ((UINT)remain & ~(UINT)(FF_MAX_SS - 1u)) : g_streamMax);
+
+                disk_stream(sink, g_fs.win);
+                res = f_read(&g_fil, iobuf, size, &retRead);
+                disk_stream(nullptr, nullptr);
+                done = retRead;
+            }
+            else
+#endif
+            {
+                /* partial sector: go through the shared buffer */
+                UINT size(FF_MAX_SS - offset);
+
+                if (size > remain)
+                {
+                    size = (UINT)remain;
+                }
+
+                if (size > SHARED_BUF_SIZE)
+                {
+                    size = SHARED_BUF_SIZE;
+                }
+
+                res = f_read(&g_fil, iobuf, size, &retRead);
+
+                for (UINT idx(0u); idx < retRead; ++idx)
+                {
+                    sink(iobuf[idx]);
+                }
+                done = retRead;
+            }
+
+            if ((FR_OK != res) || (0u == done))
+            {
+                DEBUG_LOGP("FileIo::stream() -> %d\r\n", res);
+                break;
+            }
+
+            streamed += done;
+        }
+
+        return f_tell(&g_fil) == f_size(&g_fil);
+    }
+
+    bool FileIo::enable(bool resume)
     {
         if (false == g_enable)
         {
-            DEBUG_LOGP("FileIo::enable()\r\n");
+            DEBUG_LOGP("FileIo::enable(%d)\r\n", resume);
 
-            DSTATUS status(disk_initialize(0));
+            STATS_BEGIN(PHASE_SDCARD);
+            DSTATUS status(resume ? disk_resume(0) : disk_initialize(0));
+            STATS_END(PHASE_SDCARD);
             DEBUG_LOGP("FileIo disk_initialize-> %d\r\n", status);
 
             if (status & STA_NOINIT)
@@ -242,12 +772,391 @@ namespace service
     bool FileIo::getVolumeSerialNumber(uint32_t& vsn)
     {
         char null (0u);
-        char label[12+1];
 
-        FRESULT res(f_getlabel(&null, label, &vsn));
+        /* no label buffer, so only the boot sector is read */
+        FRESULT res(f_getlabel(&null, nullptr, &vsn));
         DEBUG_LOGP("FileIo::vsn(%04lx-%04lx) -> %02x\r\n", vsn>>16, (vsn&0xFFFF), res);
 
         return FR_OK == res;
     }
 
-}
\ No newline at end of file
+}
+
+static FRESULT mountVolume(void)
+{
+#if WITH_MOUNT_CACHE != 0
+    if ((0u != g_mountCache.fs_type) &&
+        (g_mountCache.crc8 ==
+            service::Crc::crc8(&g_mountCache, offsetof(MountCache, crc8))) &&
+        (FR_OK == f_mount(&g_fs, "", 0)) &&
+        (0u == (disk_status(0) & STA_NOINIT)))
+    {
+        g_fs.pdrv = 0u;
+        g_fs.n_fats = g_mountCache.n_fats;
+        g_fs.n_rootdir = g_mountCache.n_rootdir;
+        g_fs.csize = g_mountCache.csize;
+        g_fs.n_fatent = g_mountCache.n_fatent;
+        g_fs.fsize = g_mountCache.fsize;
+        g_fs.volbase = g_mountCache.volbase;
+        g_fs.fatbase = g_mountCache.fatbase;
+        g_fs.dirbase = g_mountCache.dirbase;
+        g_fs.database = g_mountCache.database;
+        g_fs.winsect = (LBA_t)0 - 1u;
+        g_fs.id = 1u;
+#if FF_FS_RPATH
+        g_fs.cdir = 0u;
+#endif
+        g_fs.fs_type = g_mountCache.fs_type;
+
+        uint32_t vsn(0u);
+        if (service::FileIo::getVolumeSerialNumber(vsn) &&
+            (vsn == g_mountCache.vsn))
+        {
+            DEBUG_LOGP("FileIo mount cache hit\r\n");
+            return FR_OK;
+        }
+    }
+
+    g_mountCache.fs_type = 0u;
+#endif
+
+    FRESULT res(f_mount(&g_fs, "", 1));
+
+#if WITH_MOUNT_CACHE != 0
+    if ((FR_OK == res) &&
+        service::FileIo::getVolumeSerialNumber(g_mountCache.vsn))
+    {
+        g_mountCache.volbase = g_fs.volbase;
+        g_mountCache.fatbase = g_fs.fatbase;
+        g_mountCache.dirbase = g_fs.dirbase;
+        g_mountCache.database = g_fs.database;
+        g_mountCache.n_fatent = g_fs.n_fatent;
+        g_mountCache.fsize = g_fs.fsize;
+        g_mountCache.n_rootdir = g_fs.n_rootdir;
+        g_mountCache.csize = g_fs.csize;
+        g_mountCache.n_fats = g_fs.n_fats;
+        g_mountCache.fs_type = g_fs.fs_type;
+        g_mountCache.crc8 =
+            service::Crc::crc8(&g_mountCache, offsetof(MountCache, crc8));
+    }
+#endif
+
+    return res;
+}
+
+static bool findFirst(void)
+{
+    char path[ALBUM_PATH_MAX];
+    albumPath(path, "");
+
+    FRESULT res(f_findfirst(&g_dir, &g_fno, path, g_fnPattern));
+    DEBUG_LOGP("FileIo f_findfirst-> %d\r\n", res);
+
+    g_status = ((FR_OK == res) && (0 != g_fno.fname[0])) ?
+        FIO_READY : FIO_ERROR;
+    g_scanPos = 0u;
+
+    return FIO_READY == g_status;
+}
+
+static FRESULT linkMap(void)
+{
+#if FF_USE_FASTSEEK
+    g_clmt[0] = sizeof(g_clmt) / sizeof(g_clmt[0]);
+    g_fil.cltbl = g_clmt;
+
+    FRESULT res(f_lseek(&g_fil, CREATE_LINKMAP));
+
+    if (FR_NOT_ENOUGH_CORE == res)
+    {
+        DEBUG_LOGP("FileIo %lu fragments\r\n", (g_clmt[0] - 2u) / 2u);
+        g_fil.cltbl = 0;
+        res = FR_OK;
+    }
+
+    return res;
+#else
+    return FR_OK;
+#endif
+}
+
+#if WITH_SD_STREAMING != 0
+static bool contiguousSector(LBA_t& sector)
+{
+#if FF_USE_FASTSEEK
+    /* a single fragment map is: size, length, start cluster, 0 */
+    if ((g_clmt == g_fil.cltbl) && (4u == g_clmt[0]))
+    {
+        sector = g_fs.database +
+            (LBA_t)(g_clmt[2] - 2u) * g_fs.csize +
+            (LBA_t)(f_tell(&g_fil) / FF_MAX_SS);
+
+        return true;
+    }
+#endif
+
+    return false;
+}
+#endif
+
+static bool seekScan(uint16_t target, service::Resume::Position& pos)
+{
+    if (target <= g_scanPos)
+    {
+        f_closedir(&g_dir);
+
+        if (!findFirst())
+        {
+            return false;
+        }
+        pos.dptr = 0u;
+    }
+
+    while (g_scanPos < target)
+    {
+        /* directory state f_findnext() starts from, see resumeScan() */
+        pos.dptr = g_dir.dptr;
+        pos.cluster = g_dir.clust;
+        pos.sector = g_dir.sect;
+
+        FRESULT res(f_findnext(&g_dir, &g_fno));
+        DEBUG_LOGP("FileIo f_findnext-> %d\r\n", res);
+
+        if (FR_OK != res)
+        {
+            g_status = FIO_ERROR;
+            return false;
+        }
+
+        if (0 == g_fno.fname[0])
+        {
+            /* reached end of entries, restart */
+            f_closedir(&g_dir);
+            pos.dptr = 0u;
+
+            /* images got removed, count them again */
+            if ((g_scanPos + 1u) != g_albumPos[g_album].count)
+            {
+                g_albumPos[g_album].count = 0u;
+            }
+
+            return findFirst();
+        }
+        ++g_scanPos;
+    }
+
+    return true;
+}
+
+static uint16_t countImages(void)
+{
+    AlbumPos& album(g_albumPos[g_album]);
+    DIR dir;
+    FILINFO fno;
+    uint16_t count(0u);
+    char path[ALBUM_PATH_MAX];
+
+    albumPath(path, "");
+
+    FRESULT res(f_findfirst(&dir, &fno, path, g_fnPattern));
+    const DWORD cluster(dir.obj.sclust);
+
+    if ((FR_OK == res) && (0u != album.count) && (cluster == album.dirClust))
+    {
+        f_closedir(&dir);
+        return album.count;
+    }
+
+    while ((FR_OK == res) && (0 != fno.fname[0]) && (0xFFFFu != count))
+    {
+        ++count;
+        res = f_findnext(&dir, &fno);
+    }
+    f_closedir(&dir);
+
+    if (FR_OK == res)
+    {
+        album.count = count;
+        album.dirClust = cluster;
+    }
+
+    return count;
+}
+
+static void beginShuffle(void)
+{
+    uint16_t count(0u);
+
+    if (g_shuffleOn && (FIO_READY == g_status))
+    {
+#if WITH_IMAGE_INDEX != 0
+        count = (0u != g_idxCount) ? g_idxCount : countImages();
+#else
+        count = countImages();
+#endif
+    }
+    DEBUG_LOGP("FileIo shuffle %u\r\n", count);
+
+    g_shuffle.begin(count, shuffleSeed());
+}
+
+static bool resumeScan(const service::Resume::Position& pos)
+{
+    const DWORD clusterBytes((DWORD)g_fs.csize * FF_MAX_SS);
+
+    if ((2u > pos.cluster) || (g_fs.n_fatent <= pos.cluster) ||
+        (pos.sector != g_fs.database +
+            (pos.cluster - 2u) * g_fs.csize +
+            (pos.dptr % clusterBytes) / FF_MAX_SS))
+    {
+        DEBUG_LOGP("FileIo resume invalid\r\n");
+        return false;
+    }
+
+    /* same directory state f_findnext() left after the saved image */
+    g_dir.dptr = pos.dptr;
+    g_dir.clust = pos.cluster;
+    g_dir.sect = pos.sector;
+    g_dir.dir = g_fs.win + (pos.dptr % FF_MAX_SS);
+
+    FRESULT res(f_findnext(&g_dir, &g_fno));
+    DEBUG_LOGP("FileIo resume f_findnext-> %d\r\n", res);
+
+    if ((FR_OK == res) && (0 != g_fno.fname[0]))
+    {
+        g_scanPos = pos.index;
+        return true;
+    }
+
+    f_closedir(&g_dir);
+
+    return findFirst();
+}
+
+#if WITH_IMAGE_INDEX != 0
+static bool loadIndex(uint16_t pos)
+{
+    IndexHeader header;
+    UINT read(0u);
+
+    char path[ALBUM_PATH_MAX];
+    albumPath(path, g_idxSuffix);
+
+    g_idxCount = 0u;
+
+    FRESULT res(f_open(&g_fil, path, FA_READ));
+    DEBUG_LOGP("FileIo index open -> %d\r\n", res);
+
+    if (FR_OK != res)
+    {
+        return false;
+    }
+
+    res = f_read(&g_fil, &header, sizeof(header), &read);
+
+    const FSIZE_t size(f_size(&g_fil));
+    f_close(&g_fil);
+
+    if ((FR_OK == res) && (sizeof(header) == read) &&
+        (!memcmp(header.signature, g_idxSignature, sizeof(g_idxSignature))) &&
+        (g_idxVersion == header.version) &&
+        (0u != header.count) &&
+        (size == sizeof(header) + (FSIZE_t)header.count * sizeof(IndexEntry)))
+    {
+        const uint16_t files(countImages());
+
+        if (files != header.files)
+        {
+            DEBUG_LOGP("FileIo index stale, %u of %u images\r\n",
+                header.files, files);
+            return false;
+        }
+
+        g_idxCount = header.count;
+        DEBUG_LOGP("FileIo index %u images\r\n", g_idxCount);
+
+        if (readIndexEntry((pos < g_idxCount) ? pos : 0u))
+        {
+            return true;
+        }
+    }
+
+    g_idxCount = 0u;
+
+    return false;
+}
+
+static bool readIndexEntry(uint16_t pos)
+{
+    IndexEntry entry;
+    UINT read(0u);
+    char path[ALBUM_PATH_MAX];
+
+    albumPath(path, g_idxSuffix);
+
+    FRESULT res(f_open(&g_fil, path, FA_READ));
+
+    if (FR_OK == res)
+    {
+        res = f_lseek(&g_fil,
+            sizeof(IndexHeader) + (FSIZE_t)pos * sizeof(IndexEntry));
+
+        if (FR_OK == res)
+        {
+            res = f_read(&g_fil, &entry, sizeof(entry), &read);
+        }
+        f_close(&g_fil);
+    }
+
+    if ((FR_OK != res) || (sizeof(entry) != read) ||
+        (2u > entry.cluster) || (g_fs.n_fatent <= entry.cluster) ||
+        (0u == entry.size) || ('\0' == entry.name[0]))
+    {
+        DEBUG_LOGP("FileIo index %u -> %d\r\n", pos, res);
+        return false;
+    }
+
+    memcpy(g_fno.fname, entry.name, sizeof(entry.name));
+    g_fno.fname[sizeof(entry.name)] = '\0';
+    g_fno.fsize = entry.size;
+    g_idxCluster = entry.cluster;
+    g_idxPos = pos;
+
+    return true;
+}
+
+static FRESULT openIndexed(void)
+{
+    /* same object setup as f_open() after its directory lookup */
+    memset(&g_fil, 0, sizeof(g_fil));
+    g_fil.obj.fs = &g_fs;
+    g_fil.obj.id = g_fs.id;
+    g_fil.obj.attr = AM_ARC;
+    g_fil.obj.sclust = g_idxCluster;
+    g_fil.obj.objsize = g_fno.fsize;
+    g_fil.flag = FA_READ;
+
+    /* Following the chain to the end fails if the clusters got freed
+     * or the chain got shorter since the index was built. With a link
+     * map the seek needs no further FAT reads.
+     */
+    FRESULT res(linkMap());
+
+    if (FR_OK == res)
+    {
+        res = f_lseek(&g_fil, g_fno.fsize);
+    }
+
+    if (FR_OK == res)
+    {
+        res = f_lseek(&g_fil, 0u);
+    }
+
+    if (FR_OK != res)
+    {
+        g_fil.obj.fs = 0;
+    }
+
+    return res;
+}
+#endif
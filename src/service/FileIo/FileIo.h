@@ -52,6 +52,16 @@ namespace service
          */
         static const uint8_t SHARED_BUF_SIZE = 100u;
 
+        /**
+         * @brief Number of albums with their own image position
+         */
+        static const uint8_t MAX_ALBUMS = 4u;
+
+        /**
+         * @brief Maximum length of an album directory name (8.3 base)
+         */
+        static const uint8_t ALBUM_NAME_MAX = 8u;
+
         /**
          * @brief Shared data buffer for file IO
          *
@@ -60,13 +70,23 @@ namespace service
          */
         static uint8_t iobuf[SHARED_BUF_SIZE];
 
+        /**
+         * @brief Sink function receiving streamed file data
+         *
+         * @param data next byte from file
+         */
+        typedef void (*StreamSink)(uint8_t data);
+
         /**
          * @brief Enable file IO access
          *
          * Power SD Card modul and initialze it
          *
+         * @param resume true if the card stayed powered since the last
+         *               access, a status check replaces the full init
+         *               if the card is still ready.
          */
-        static bool enable();
+        static bool enable(bool resume = false);
 
         /**
          * @brief Disable FileIO
@@ -77,13 +97,39 @@ namespace service
         /**
          * @brief Initialize FileIO
          *
-         * FatFS mount and directory read initialisation.
+         * FatFS mount and loading of the saved image position. Files
+         * can be opened by path afterwards, setAlbum() selects the
+         * images. Call after enable().
          *
          * @return true All worked fine
          * @return false error occured
          */
         static bool init();
 
+        /**
+         * @brief Select the album to show images from
+         *
+         * Albums are the directories /epd/<name>, with an optional
+         * image index /epd/<name>.idx. Each album keeps its image
+         * position while other albums are shown. Only the selected
+         * album directory gets read.
+         *
+         * @param album album number (0..MAX_ALBUMS-1)
+         * @param name  directory name, nullptr for the default "img"
+         * @return true  album has images, the current one is selected
+         * @return false directory missing, empty or read error
+         */
+        static bool setAlbum(uint8_t album, const char * name = nullptr);
+
+        /**
+         * @brief Get the selected album
+         *
+         * After init() it is the album of the saved image position.
+         *
+         * @return uint8_t album number
+         */
+        static uint8_t getAlbum(void);
+
         /**
          * @brief open given file
          *
@@ -108,6 +154,17 @@ namespace service
          */
         static bool next();
 
+        /**
+         * @brief Select random or directory play order for next()
+         *
+         * The random order is a permutation of all images, so each one
+         * shows up once per round. It is the same for a card over
+         * resets. Without image index the images get counted once.
+         *
+         * @param enable true for random order
+         */
+        static void setShuffle(bool enable);
+
         /**
          * @brief read a block from open file
          *
@@ -119,6 +176,55 @@ namespace service
          */
         static bool read(void * buf, uint16_t size, uint16_t& read);
 
+        /**
+         * @brief Get the size of the open file
+         *
+         * @return uint32_t size in bytes, 0 if no file is open
+         */
+        static uint32_t getFileSize(void);
+
+        /**
+         * @brief Open a second file next to the open one
+         *
+         * Window images read their base image alongside the window
+         * data. Both files share the FatFS sector window, so switching
+         * between them reloads a sector. close() closes both files.
+         *
+         * @param fname file name in the album directory
+         * @return true  base file open
+         * @return false no file open or base file not found
+         */
+        static bool openBase(const char * fname);
+
+        /**
+         * @brief read a block from the base file
+         *
+         * @param buf buffer to receive data
+         * @param size number of bytes in buffer
+         * @param read return number of byes read
+         * @return true
+         * @return false
+         */
+        static bool readBase(void * buf, uint16_t size, uint16_t& read);
+
+        /**
+         * @brief stream the remaining bytes of the open file into a sink
+         *
+         * With WITH_SD_STREAMING enabled, whole sectors are passed from
+         * the SD card to the sink without an intermediate copy in RAM.
+         * The SD card is deselected during each sink call, so the sink
+         * may use the SPI bus for another device with the same SPI
+         * settings. Only unaligned bytes at the start or end of the
+         * file are read through iobuf. Without streaming all bytes go
+         * through iobuf.
+         *
+         * @param sink function to call for every byte
+         * @param streamed return number of bytes streamed
+         * @return true  file streamed up to its end
+         * @return false read error occured
+         */
+        static bool stream(StreamSink sink, uint32_t& streamed);
+
         /**
          * @brief Get the Volume Serial Number of mounted FS
          *
@@ -0,0 +1,76 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GOVERNOR_H_INCLUDED
+#define GOVERNOR_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Battery adaptive update interval
+     *
+     * Below a knee voltage, the sleep time gets stretched linearly
+     * with the falling supply voltage, up to a maximum stretch at the
+     * low battery limit. Fresh batteries give back the normal interval.
+     * This spreads the remaining capacity over more days instead of
+     * running into the low battery state at the full update rate.
+     */
+    class Governor
+    {
+        public:
+            /** Stretch for the unchanged interval in percent */
+            static const uint16_t NO_STRETCH = 100u;
+
+            /**
+             * @brief Get the interval stretch for a supply voltage
+             *
+             * @param voltage    supply voltage in mV
+             * @param minVoltage low battery limit in mV
+             * @param knee       voltage to start stretching at in mV,
+             *                   0 turns the governor off
+             * @param maxStretch stretch at minVoltage in percent
+             * @return uint16_t stretch in percent, at least NO_STRETCH
+             */
+            static uint16_t getStretch(
+                uint16_t voltage, uint16_t minVoltage,
+                uint16_t knee, uint16_t maxStretch);
+
+        private:
+            Governor();
+            Governor(const Governor&);
+            Governor& operator=(const Governor&);
+    };
+}
+
+#endif /* GOVERNOR_H_INCLUDED */
@@ -0,0 +1,266 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Image/FileSource.h"
+
+#include "service/Display/Display.h"
+#include "service/FileIo/FileIo.h"
+
+#include <util/crc16.h>
+
+/** CRC of the bytes streamed by crcStreamByte()
+ */
+static uint16_t g_streamCrc;
+
+/** Stream sink updating the CRC on the way to the display
+ *
+ * @param data next byte from file
+ */
+static void crcStreamByte(uint8_t data)
+{
+    g_streamCrc = _crc_ccitt_update(g_streamCrc, data);
+    service::Epd::streamByte(data);
+}
+
+namespace service
+{
+    FileSource::FileSource() :
+        m_buf(FileIo::iobuf),
+        m_read(FileIo::read),
+        m_total(0u),
+        m_crc(0xFFFFu),
+        m_pos(0u),
+        m_len(0u),
+        m_size(FileIo::SHARED_BUF_SIZE),
+        m_error(false),
+        m_crcOn(false)
+    {
+    }
+
+    FileSource::FileSource(uint8_t * buf, uint8_t size, Reader read) :
+        m_buf(buf),
+        m_read(read),
+        m_total(0u),
+        m_crc(0xFFFFu),
+        m_pos(0u),
+        m_len(0u),
+        m_size(size),
+        m_error(false),
+        m_crcOn(false)
+    {
+    }
+
+    bool FileSource::begin(void)
+    {
+        m_total = 0u;
+        m_pos = 0u;
+        m_len = 0u;
+        m_error = false;
+        m_crcOn = false;
+
+        return fill();
+    }
+
+    void FileSource::beginCrc(void)
+    {
+        m_crcOn = true;
+        m_crc = 0xFFFFu;
+
+        for (uint8_t idx(m_pos); idx < m_len; ++idx)
+        {
+            m_crc = _crc_ccitt_update(m_crc, m_buf[idx]);
+        }
+    }
+
+    const uint8_t * FileSource::peek(uint8_t size) const
+    {
+        return ((m_len - m_pos) < size) ? nullptr : &m_buf[m_pos];
+    }
+
+    bool FileSource::read(void * buf, uint8_t size)
+    {
+        uint8_t * dst((uint8_t *)buf);
+
+        while (0u != size)
+        {
+            if (!get(*dst++))
+            {
+                return false;
+            }
+            --size;
+        }
+
+        return true;
+    }
+
+    bool FileSource::get(uint8_t& data)
+    {
+        if ((m_pos == m_len) && !fill())
+        {
+            return false;
+        }
+
+        data = m_buf[m_pos++];
+
+        return true;
+    }
+
+    uint16_t FileSource::next(uint8_t& value, uint16_t max)
+    {
+        if (!get(value))
+        {
+            return 0u;
+        }
+
+        /* merge identical bytes, only as far as they are buffered */
+        uint16_t run(1u);
+
+        while ((run < max) && (m_pos < m_len) &&
+               (value == m_buf[m_pos]))
+        {
+            ++m_pos;
+            ++run;
+        }
+
+        return run;
+    }
+
+    bool FileSource::stream(uint32_t& sent)
+    {
+        uint32_t streamed(0u);
+
+        if (FileIo::iobuf != m_buf)
+        {
+            return false;   /* not the file opened with FileIo::open() */
+        }
+
+        /* bytes already buffered go first */
+        sent = m_len - m_pos;
+        while (m_pos < m_len)
+        {
+            Epd::streamByte(m_buf[m_pos++]);
+        }
+
+        bool done;
+
+        if (m_crcOn)
+        {
+            g_streamCrc = m_crc;
+            done = FileIo::stream(crcStreamByte, streamed);
+            m_crc = g_streamCrc;
+        }
+        else
+        {
+            done = FileIo::stream(Epd::streamByte, streamed);
+        }
+
+        if (!done)
+        {
+            m_error = true;
+        }
+
+        sent += streamed;
+        m_total += streamed;
+
+        return true;
+    }
+
+    bool FileSource::fill(void)
+    {
+        uint16_t read(0u);
+
+        m_pos = 0u;
+        m_len = 0u;
+
+        if (m_error)
+        {
+            return false;
+        }
+
+        if (!m_read(m_buf, m_size, read))
+        {
+            m_error = true;
+            return false;
+        }
+
+        m_len = (uint8_t)read;
+        m_total += read;
+
+        if (m_crcOn)
+        {
+            for (uint8_t idx(0u); idx < m_len; ++idx)
+            {
+                m_crc = _crc_ccitt_update(m_crc, m_buf[idx]);
+            }
+        }
+
+        return 0u != m_len;
+    }
+
+    RleSource::RleSource() :
+        m_file(nullptr),
+        m_count(0u),
+        m_value(0u)
+    {
+    }
+
+    void RleSource::begin(FileSource& file)
+    {
+        m_file = &file;
+        m_rle.reset();
+        m_count = 0u;
+    }
+
+    uint16_t RleSource::next(uint8_t& value, uint16_t max)
+    {
+        while (0u == m_count)
+        {
+            if (!m_rle.get(m_value, m_count))
+            {
+                uint8_t code;
+
+                if (!m_file->get(code))
+                {
+                    return 0u;
+                }
+                m_rle.put(code);
+            }
+        }
+
+        const uint16_t run((m_count < max) ? m_count : max);
+
+        value = m_value;
+        m_count -= run;
+
+        return run;
+    }
+}
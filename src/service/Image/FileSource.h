@@ -0,0 +1,185 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FILESOURCE_H_INCLUDED
+#define FILESOURCE_H_INCLUDED
+
+#include <stdint.h>
+
+#include "service/Display/PixelSource.h"
+#include "service/Image/RleDecoder.h"
+
+namespace service
+{
+    /**
+     * @brief Pixel source reading raw pixel data from the open file
+     *
+     * Reads the file opened with FileIo::open() through the shared
+     * FileIo::iobuf. Identical bytes in the buffer are merged into runs.
+     * As the only source of a frame, stream() sends the file with the
+     * zero copy SD card streaming instead.
+     *
+     * A source with its own buffer and reader reads another file, i.e.
+     * the base image of a window image. It has no stream().
+     */
+    class FileSource : public PixelSource
+    {
+        public:
+
+            /**
+             * @brief Function reading from a file, @see FileIo::read
+             */
+            typedef bool (*Reader)(void * buf, uint16_t size, uint16_t& read);
+
+            FileSource();
+
+            /**
+             * @param buf  buffer for file data
+             * @param size buffer size
+             * @param read function reading the file
+             */
+            FileSource(uint8_t * buf, uint8_t size, Reader read);
+
+            /**
+             * @brief Start reading at the current file position
+             *
+             * @return true  data available
+             * @return false read error or empty file
+             */
+            bool begin(void);
+
+            /**
+             * @brief Get buffered bytes without consuming them
+             *
+             * @param size number of bytes needed
+             * @return const uint8_t* bytes, nullptr if less are buffered
+             */
+            const uint8_t * peek(uint8_t size) const;
+
+            /**
+             * @brief Read bytes from file
+             *
+             * @param buf  buffer to receive data
+             * @param size number of bytes to read
+             * @return true  all bytes read
+             * @return false end of file or read error
+             */
+            bool read(void * buf, uint8_t size);
+
+            /**
+             * @brief Read the next byte from file
+             *
+             * @param[out] data next byte
+             * @return true  byte read
+             * @return false end of file or read error
+             */
+            bool get(uint8_t& data);
+
+            /**
+             * @brief Number of bytes read from file
+             */
+            uint32_t getTotal(void) const
+            {
+                return m_total;
+            }
+
+            /**
+             * @brief Reading stopped by a read error
+             */
+            bool hasError(void) const
+            {
+                return m_error;
+            }
+
+            /**
+             * @brief Start a CRC-CCITT over all bytes not yet consumed
+             *
+             * The CRC covers every byte read from file afterwards,
+             * including the ones sent by stream().
+             */
+            void beginCrc(void);
+
+            /**
+             * @brief CRC since beginCrc()
+             */
+            uint16_t getCrc(void) const
+            {
+                return m_crc;
+            }
+
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+            virtual bool stream(uint32_t& sent) override;
+
+        private:
+            /** Refill the buffer from file */
+            bool fill(void);
+
+            uint8_t * m_buf;    /**< buffer for file data        */
+            Reader   m_read;    /**< reads the file              */
+            uint32_t m_total;   /**< bytes read from file        */
+            uint16_t m_crc;     /**< CRC of bytes read           */
+            uint8_t  m_pos;     /**< next byte in buffer         */
+            uint8_t  m_len;     /**< bytes in buffer             */
+            uint8_t  m_size;    /**< buffer size                 */
+            bool     m_error;   /**< read error occured          */
+            bool     m_crcOn;   /**< update m_crc while reading  */
+    };
+
+    /**
+     * @brief Pixel source decoding run length encoded file data
+     *
+     * @see RleDecoder
+     */
+    class RleSource : public PixelSource
+    {
+        public:
+
+            RleSource();
+
+            /**
+             * @brief Start decoding
+             *
+             * @param file source of code bytes
+             */
+            void begin(FileSource& file);
+
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+
+        private:
+            FileSource * m_file;    /**< code byte input           */
+            RleDecoder   m_rle;     /**< decoder state             */
+            uint16_t     m_count;   /**< bytes left in current run */
+            uint8_t      m_value;   /**< byte of current run       */
+    };
+}
+
+#endif /* FILESOURCE_H_INCLUDED */
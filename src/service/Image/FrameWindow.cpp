@@ -0,0 +1,159 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Image/FrameWindow.h"
+
+namespace service
+{
+    FrameWindow::FrameWindow() :
+        m_outer(nullptr),
+        m_inner(nullptr),
+        m_frameBytes(0u),
+        m_left(0u),
+        m_right(0u),
+        m_top(0u),
+        m_bottom(0u),
+        m_col(0u),
+        m_row(0u)
+    {
+    }
+
+    bool FrameWindow::begin(
+        uint16_t frameWidth, uint16_t frameHeight,
+        uint16_t x, uint16_t y,
+        uint16_t width, uint16_t height,
+        PixelSource& outer, PixelSource& inner)
+    {
+        if ((0u != ((x | width | frameWidth) & 1u)) ||
+            (0u == width) || (0u == height) ||
+            (frameWidth < width) || ((frameWidth - width) < x) ||
+            (frameHeight < height) || ((frameHeight - height) < y))
+        {
+            return false;
+        }
+
+        m_outer = &outer;
+        m_inner = &inner;
+        m_frameBytes = frameWidth >> 1u;
+        m_left = x >> 1u;
+        m_right = m_left + (width >> 1u);
+        m_top = y;
+        m_bottom = y + height;
+        m_col = 0u;
+        m_row = 0u;
+
+        return true;
+    }
+
+    uint16_t FrameWindow::next(uint8_t& value, uint16_t max)
+    {
+        uint16_t end(m_frameBytes);
+        bool inside(false);
+
+        if ((m_row >= m_top) && (m_row < m_bottom))
+        {
+            if (m_col < m_left)
+            {
+                end = m_left;
+            }
+            else if (m_col < m_right)
+            {
+                end = m_right;
+                inside = true;
+            }
+        }
+
+        uint16_t run(end - m_col);
+
+        if (run > max)
+        {
+            run = max;
+        }
+
+        if (inside)
+        {
+            if (m_left == m_col)
+            {
+                skipOuter(m_right - m_left);
+            }
+
+            const uint16_t count(m_inner->next(value, run));
+
+            if (0u != count)
+            {
+                run = count;
+            }
+            else
+            {
+                value = FILL;
+            }
+        }
+        else
+        {
+            const uint16_t count(m_outer->next(value, run));
+
+            if (0u != count)
+            {
+                run = count;
+            }
+            else
+            {
+                value = FILL;
+            }
+        }
+
+        m_col += run;
+        if (m_frameBytes == m_col)
+        {
+            m_col = 0u;
+            ++m_row;
+        }
+
+        return run;
+    }
+
+    void FrameWindow::skipOuter(uint16_t count)
+    {
+        uint8_t value;
+
+        while (0u != count)
+        {
+            const uint16_t run(m_outer->next(value, count));
+
+            if (0u == run)
+            {
+                break;
+            }
+            count -= run;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FRAMEWINDOW_H_INCLUDED
+#define FRAMEWINDOW_H_INCLUDED
+
+#include <stdint.h>
+
+#include "service/Display/PixelSource.h"
+
+namespace service
+{
+    /**
+     * @brief Place the pixel data of a window inside a full frame
+     *
+     * The display controller has no partial update, every refresh needs
+     * a full frame. Images that only change a small area carry just the
+     * pixel data of that window. Everything outside comes from an outer
+     * full frame source, i.e. the unchanged base image or a background
+     * color. The outer data covered by the window gets skipped.
+     *
+     * All positions and sizes are in pixels, horizontal ones must be
+     * even as each byte holds 2 pixel.
+     */
+    class FrameWindow : public PixelSource
+    {
+        public:
+
+            FrameWindow();
+
+            /**
+             * @brief Start a frame
+             *
+             * @param frameWidth  frame width
+             * @param frameHeight frame height
+             * @param x           window left column
+             * @param y           window top row
+             * @param width       window width
+             * @param height      window height
+             * @param outer       source of the full frame
+             * @param inner       source of window pixel data
+             * @return true  window fits into frame
+             * @return false invalid window
+             */
+            bool begin(
+                uint16_t frameWidth, uint16_t frameHeight,
+                uint16_t x, uint16_t y,
+                uint16_t width, uint16_t height,
+                PixelSource& outer, PixelSource& inner);
+
+            /**
+             * @brief Get the next run of frame data
+             *
+             * Missing window or outer data is replaced by white.
+             */
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+
+        private:
+            /** Byte value for missing data, 2 white pixel */
+            static const uint8_t FILL = 0x11u;
+
+            /** Drop outer data covered by the window
+             *
+             * @param count number of bytes
+             */
+            void skipOuter(uint16_t count);
+
+            PixelSource * m_outer;  /**< source of the full frame       */
+            PixelSource * m_inner;  /**< source of window pixel data    */
+            uint16_t m_frameBytes;  /**< frame bytes per row            */
+            uint16_t m_left;        /**< first window byte in row       */
+            uint16_t m_right;       /**< first byte right of window     */
+            uint16_t m_top;         /**< first window row               */
+            uint16_t m_bottom;      /**< first row below window         */
+            uint16_t m_col;         /**< byte column in current row     */
+            uint16_t m_row;         /**< current row                    */
+    };
+}
+
+#endif /* FRAMEWINDOW_H_INCLUDED */
@@ -0,0 +1,321 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Image/Image.h"
+#include "service/Image/FileSource.h"
+#include "service/Image/FrameWindow.h"
+
+#include "service/Display/Display.h"
+#include "service/FileIo/FileIo.h"
+#include "service/Debug/Debug.h"
+
+#include <avr/pgmspace.h>
+#include <string.h>
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/** Image header signature
+ */
+static const uint8_t g_signature[] PROGMEM = { 0xFE, 'E', 'P', 'D' };
+
+/** Oldest and newest supported header version
+ */
+static const uint8_t g_versionMin = 1u;
+static const uint8_t g_versionMax = 2u;
+
+/** Raw pixel data or code bytes from file
+ */
+static service::FileSource g_file;
+
+/** Decoder for run length encoded images
+ */
+static service::RleSource g_rle;
+
+/** Buffer for the base image of a window image, the shared
+ *  FileIo::iobuf holds the window data
+ */
+static uint8_t g_baseBuf[32];
+
+/** Base image data of a window image
+ */
+static service::FileSource g_baseFile(
+    g_baseBuf, sizeof(g_baseBuf), service::FileIo::readBase);
+
+/** Decoder for a run length encoded base image
+ */
+static service::RleSource g_baseRle;
+
+/** Color outside a window image without base image
+ */
+static service::SolidSource g_background(service::Epd::WHITE);
+
+/** Placement of window images into the frame
+ */
+static service::FrameWindow g_window;
+
+/** Source for the frame, set up by prepare(), nullptr if not ready
+ */
+static service::PixelSource * g_source = nullptr;
+
+/** Expected payload CRC of a version 2 image
+ */
+static uint16_t g_crc;
+
+/** Payload CRC to check after painting
+ */
+static bool g_checkCrc;
+
+/** Read the image header and set up the decoder for its encoding
+ *
+ * @param file        file source, started with begin()
+ * @param rle         decoder for run length encoded data
+ * @param[out] header image header, version 0 for headerless raw data
+ * @return service::PixelSource* pixel data, nullptr if unsupported
+ */
+static service::PixelSource * readHeader(
+    service::FileSource& file, service::RleSource& rle,
+    service::Image::HeaderV1& header)
+{
+    const uint8_t * peek(file.peek(sizeof(header)));
+
+    memset(&header, 0, sizeof(header));
+
+    if ((nullptr == peek) ||
+        (0 != memcmp_P(peek, g_signature, sizeof(g_signature))))
+    {
+        /* headerless raw image, buffered bytes are pixel data */
+        return &file;
+    }
+
+    file.read(&header, sizeof(header));
+
+    DEBUG_LOGP("Image v%d enc %d\r\n", header.version, header.encoding);
+
+    if ((g_versionMin > header.version) || (g_versionMax < header.version))
+    {
+        return nullptr;
+    }
+
+    switch (header.encoding)
+    {
+        case service::Image::ENC_RAW:
+            return &file;
+
+        case service::Image::ENC_RLE:
+            rle.begin(file);
+            return &rle;
+
+        default:
+            return nullptr;
+    }
+}
+
+/** Open the base image of a window image
+ *
+ * @param base base image record
+ * @return service::PixelSource* full frame data, nullptr if unusable
+ */
+static service::PixelSource * openBase(const service::Image::BaseV1& base)
+{
+    char name[sizeof(base.name) + 1u];
+
+    memcpy(name, base.name, sizeof(base.name));
+    name[sizeof(base.name)] = '\0';
+
+    if (!service::FileIo::openBase(name) || !g_baseFile.begin())
+    {
+        return nullptr;
+    }
+
+    service::Image::HeaderV1 header;
+    service::PixelSource * source(readHeader(g_baseFile, g_baseRle, header));
+
+    if ((nullptr == source) || (0u != header.flags))
+    {
+        return nullptr;
+    }
+
+    if (2u <= header.version)
+    {
+        service::Image::InfoV2 info;
+
+        if ((!g_baseFile.read(&info, sizeof(info))) ||
+            (service::Epd::getWidth() != info.width) ||
+            (service::Epd::getHeight() != info.height))
+        {
+            return nullptr;
+        }
+    }
+
+    return source;
+}
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace service
+{
+    bool Image::prepare(void)
+    {
+        g_source = nullptr;
+        g_checkCrc = false;
+
+        if (!g_file.begin())
+        {
+            return false;
+        }
+
+        HeaderV1 header;
+        PixelSource * source(readHeader(g_file, g_rle, header));
+        uint32_t headerSize(sizeof(header));
+        uint16_t width(Epd::getWidth());
+        uint16_t height(Epd::getHeight());
+
+        if (nullptr == source)
+        {
+            return false;
+        }
+
+        if (0u != (header.flags & FLAG_WINDOW))
+        {
+            WindowV1 rect;
+            PixelSource * outer(&g_background);
+
+            if (!g_file.read(&rect, sizeof(rect)))
+            {
+                return false;
+            }
+            headerSize += sizeof(rect);
+
+            DEBUG_LOGP("Window %d,%d %dx%d\r\n",
+                rect.x, rect.y, rect.width, rect.height);
+
+            if (0u != (header.flags & FLAG_BASE))
+            {
+                BaseV1 base;
+
+                if (!g_file.read(&base, sizeof(base)))
+                {
+                    return false;
+                }
+                headerSize += sizeof(base);
+
+                /* without its base the window would wipe the frame */
+                outer = openBase(base);
+                if (nullptr == outer)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                g_background = SolidSource(rect.background & 0x07u);
+            }
+
+            if (!g_window.begin(
+                Epd::getWidth(), Epd::getHeight(),
+                rect.x, rect.y, rect.width, rect.height,
+                *outer, *source))
+            {
+                return false;
+            }
+
+            width = rect.width;
+            height = rect.height;
+            source = &g_window;
+        }
+
+        if (2u <= header.version)
+        {
+            InfoV2 info;
+
+            if (!g_file.read(&info, sizeof(info)))
+            {
+                return false;
+            }
+            headerSize += sizeof(info);
+
+            DEBUG_LOGP("Info %dx%d %ld crc %04x\r\n",
+                info.width, info.height, info.payload, info.crc);
+
+            /* truncated, padded or for another display */
+            if ((width != info.width) || (height != info.height) ||
+                (FileIo::getFileSize() != headerSize + info.payload) ||
+                ((ENC_RAW == header.encoding) &&
+                 (info.payload != (uint32_t)width * height / 2u)))
+            {
+                return false;
+            }
+
+            g_crc = info.crc;
+            g_checkCrc = true;
+            g_file.beginCrc();
+        }
+
+        g_source = source;
+
+        return true;
+    }
+
+    bool Image::paint(uint32_t& total, Overlay * overlay)
+    {
+        total = 0u;
+
+        if (nullptr == g_source)
+        {
+            return false;
+        }
+
+        PixelSource * source(g_source);
+        g_source = nullptr;
+
+        if (nullptr != overlay)
+        {
+            overlay->setBase(*source);
+            source = overlay;
+        }
+
+        Epd::paint(*source);
+
+        total = g_file.getTotal();
+
+        if (g_checkCrc && (g_crc != g_file.getCrc()))
+        {
+            DEBUG_LOGP("Image crc %04x\r\n", g_file.getCrc());
+            return false;
+        }
+
+        return !g_file.hasError();
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IMAGE_H_INCLUDED
+#define IMAGE_H_INCLUDED
+
+#include <stdint.h>
+
+#include "service/Overlay/Overlay.h"
+
+namespace service
+{
+    /**
+     * @brief Image file handling
+     *
+     * An image file is either plain raw pixel data (2 pixel per byte)
+     * or starts with a header that defines the encoding of the pixel
+     * data following it:
+     *
+     *     0xFE 'E' 'P' 'D' <version> <encoding> <flags> <reserved>
+     *
+     * The leading 0xFE can never start raw data, as pixel values are
+     * limited to 0..7.
+     *
+     * With FLAG_WINDOW set, a WindowV1 record follows the header and
+     * the pixel data only covers that window, @see FrameWindow. With
+     * FLAG_BASE also set, a BaseV1 record names the full frame image
+     * shown outside the window.
+     *
+     * Version 2 headers end with an InfoV2 record describing the pixel
+     * data. It gets checked against the frame and file size before
+     * anything is sent to the display, the CRC after sending.
+     */
+    class Image
+    {
+        public:
+
+            /**
+             * @brief Pixel data encodings
+             */
+            enum Encoding
+            {
+                ENC_RAW = 0u,   /**< 2 pixel per byte                */
+                ENC_RLE = 1u    /**< run length encoded, @see RleDecoder */
+            };
+
+            /**
+             * @brief Header flags
+             */
+            enum Flags
+            {
+                FLAG_WINDOW = 0x01u,    /**< WindowV1 follows header     */
+                FLAG_BASE   = 0x02u     /**< BaseV1 follows WindowV1     */
+            };
+
+            /**
+             * @brief Version 1 image header
+             */
+            struct HeaderV1
+            {
+                uint8_t signature[4];  /**< 0xFE 'E' 'P' 'D'          */
+                uint8_t version;       /**< header version (1..2)     */
+                uint8_t encoding;      /**< @see enum Encoding        */
+                uint8_t flags;         /**< @see enum Flags           */
+                uint8_t reserved;      /**< set to 0                  */
+            };
+
+            /**
+             * @brief Window image record (little endian)
+             *
+             * Pixel data covers the given rectangle only, the rest
+             * of the frame comes from the base image (FLAG_BASE) or
+             * gets the background color.
+             */
+            struct WindowV1
+            {
+                uint16_t x;            /**< left column (even)        */
+                uint16_t y;            /**< top row                   */
+                uint16_t width;        /**< width (even)              */
+                uint16_t height;       /**< height                    */
+                uint8_t  background;   /**< color index outside       */
+                uint8_t  reserved;     /**< set to 0                  */
+            };
+
+            /**
+             * @brief Base image record of a window image
+             *
+             * The base is a full frame image without window in the
+             * same album directory, raw or run length encoded. Its
+             * payload CRC is not checked.
+             */
+            struct BaseV1
+            {
+                char name[12];         /**< 8.3 file name, 0 padded   */
+            };
+
+            /**
+             * @brief Version 2 pixel data record (little endian)
+             *
+             * Last record of a version 2 header.
+             */
+            struct InfoV2
+            {
+                uint16_t width;        /**< pixel data width          */
+                uint16_t height;       /**< pixel data height         */
+                uint32_t payload;      /**< bytes after the header    */
+                uint16_t crc;          /**< CRC-CCITT of the payload  */
+                uint16_t reserved;     /**< set to 0                  */
+            };
+
+            /**
+             * @brief Check the open image file before painting it
+             *
+             * Reads the image header (if any) from the file opened with
+             * FileIo::open() and sets up the pixel sources for its
+             * encoding. Doesn't touch the display, so bad files can be
+             * skipped before powering it.
+             *
+             * The width and height of a version 2 header must match the
+             * frame (or window), the payload size the file size and for
+             * raw data the pixel count.
+             *
+             * @return true  image can be painted
+             * @return false unsupported or inconsistent header
+             */
+            static bool prepare(void);
+
+            /**
+             * @brief Paint the open image file
+             *
+             * Sends the frame prepared by prepare() with Epd::paint().
+             * Call Epd::endPaint() afterwards to show it.
+             *
+             * @param[out] total number of bytes read from file
+             * @param overlay optional overlay, already started with
+             *                Overlay::begin()
+             * @return true  image was sent
+             * @return false not prepared (nothing sent), read error or
+             *               payload CRC mismatch
+             */
+            static bool paint(uint32_t& total, Overlay * overlay = nullptr);
+
+        private:
+            Image();
+            Image(const Image&);
+            Image& operator=(const Image&);
+    };
+}
+
+#endif /* IMAGE_H_INCLUDED */
@@ -0,0 +1,118 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Image/RleDecoder.h"
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+static const uint8_t  RLE_EXTENDED  = 0x80u;  /**< flag for 2 byte runs      */
+static const uint8_t  RLE_COLORMASK = 0x07u;  /**< color index bits          */
+static const uint16_t RLE_EXT_BASE  = 17u;    /**< min length of 2 byte runs */
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace service
+{
+    RleDecoder::RleDecoder()
+    {
+        reset();
+    }
+
+    void RleDecoder::reset(void)
+    {
+        m_pixel = 0u;
+        m_color = 0u;
+        m_code = 0u;
+        m_extended = false;
+        m_half = false;
+        m_high = 0u;
+    }
+
+    bool RleDecoder::put(uint8_t code)
+    {
+        if (m_extended)
+        {
+            /* 2nd byte of a long run */
+            m_extended = false;
+            m_color = m_code & RLE_COLORMASK;
+            m_pixel = (((uint16_t)(m_code & 0x78u) << 5) | code) + RLE_EXT_BASE;
+        }
+        else if (0u != (code & RLE_EXTENDED))
+        {
+            m_extended = true;
+            m_code = code;
+        }
+        else
+        {
+            m_color = code & RLE_COLORMASK;
+            m_pixel = ((code >> 3) & 0x0Fu) + 1u;
+        }
+
+        return 0u != m_pixel;
+    }
+
+    bool RleDecoder::get(uint8_t& value, uint16_t& count)
+    {
+        if (0u == m_pixel)
+        {
+            return false;
+        }
+
+        if (m_half)
+        {
+            /* complete byte with pixel left over from previous run */
+            value = (uint8_t)((m_high << 4) | m_color);
+            count = 1u;
+            m_half = false;
+            --m_pixel;
+            return true;
+        }
+
+        if (1u == m_pixel)
+        {
+            /* odd pixel gets paired with the next run */
+            m_high = m_color;
+            m_half = true;
+            m_pixel = 0u;
+            return false;
+        }
+
+        value = (uint8_t)((m_color << 4) | m_color);
+        count = m_pixel >> 1u;
+        m_pixel &= 1u;
+
+        return true;
+    }
+}
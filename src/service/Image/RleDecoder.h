@@ -0,0 +1,97 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RLEDECODER_H_INCLUDED
+#define RLEDECODER_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Decoder for run length encoded EPD pixel data
+     *
+     * The encoding works on the stream of 4 bit pixels. Each code byte
+     * describes a run of pixels with the same color:
+     *
+     *     0LLLLCCC            run of LLLL + 1 pixel (1..16)
+     *     1HHHHCCC LLLLLLLL   run of HHHHLLLLLLLL + 17 pixel (17..4112)
+     *
+     * CCC is the color index. Runs may span several display rows.
+     *
+     * The decoder turns the pixel runs back into runs of identical
+     * output bytes (2 pixels per byte), so that callers can send them
+     * without expanding them into a buffer first.
+     */
+    class RleDecoder
+    {
+        public:
+
+            RleDecoder();
+
+            /**
+             * @brief Restart decoding at the start of an image
+             */
+            void reset(void);
+
+            /**
+             * @brief Feed the next code byte into the decoder
+             *
+             * @param code next byte of encoded data
+             * @return true  decoded pixel are available, call get()
+             * @return false more code bytes needed
+             */
+            bool put(uint8_t code);
+
+            /**
+             * @brief Get next run of identical output bytes
+             *
+             * Call until it returns false after put() returned true.
+             *
+             * @param[out] value byte value holding 2 pixel
+             * @param[out] count number of times value repeats
+             * @return true  value and count are valid
+             * @return false more code bytes needed
+             */
+            bool get(uint8_t& value, uint16_t& count);
+
+        private:
+            uint16_t m_pixel;     /**< pixel left in current run        */
+            uint8_t  m_color;     /**< color of current run             */
+            uint8_t  m_code;      /**< pending code of a 2 byte run     */
+            bool     m_extended;  /**< waiting for 2nd byte of a run    */
+            bool     m_half;      /**< m_high holds an unpaired pixel   */
+            uint8_t  m_high;      /**< unpaired pixel (upper nibble)    */
+    };
+}
+
+#endif /* RLEDECODER_H_INCLUDED */
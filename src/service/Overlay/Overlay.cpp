@@ -0,0 +1,318 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Overlay/Overlay.h"
+
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/** First and last character in font table */
+static const char FONT_FIRST = 0x20;
+static const char FONT_LAST  = 0x5F;
+
+/** Columns with glyph data, the 6th column is spacing */
+static const uint8_t FONT_COLUMNS = 5u;
+
+/** 5x7 font for ASCII 0x20..0x5F, one byte per column, bit 0 = top row
+ */
+static const uint8_t g_font[][FONT_COLUMNS] PROGMEM =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ' ' */
+    { 0x00, 0x00, 0x5F, 0x00, 0x00 }, /* '!' */
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, /* '"' */
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, /* '#' */
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, /* '$' */
+    { 0x23, 0x13, 0x08, 0x64, 0x62 }, /* '%' */
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, /* '&' */
+    { 0x00, 0x08, 0x07, 0x03, 0x00 }, /* ''' */
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, /* '(' */
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, /* ')' */
+    { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, /* '*' */
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 }, /* '+' */
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, /* ',' */
+    { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* '-' */
+    { 0x00, 0x00, 0x60, 0x60, 0x00 }, /* '.' */
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, /* '/' */
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, /* '0' */
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 }, /* '1' */
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, /* '2' */
+    { 0x21, 0x41, 0x49, 0x4D, 0x33 }, /* '3' */
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, /* '4' */
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, /* '5' */
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, /* '6' */
+    { 0x41, 0x21, 0x11, 0x09, 0x07 }, /* '7' */
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, /* '8' */
+    { 0x46, 0x49, 0x49, 0x29, 0x1E }, /* '9' */
+    { 0x00, 0x00, 0x14, 0x00, 0x00 }, /* ':' */
+    { 0x00, 0x40, 0x34, 0x00, 0x00 }, /* ';' */
+    { 0x00, 0x08, 0x14, 0x22, 0x41 }, /* '<' */
+    { 0x14, 0x14, 0x14, 0x14, 0x14 }, /* '=' */
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, /* '>' */
+    { 0x02, 0x01, 0x59, 0x09, 0x06 }, /* '?' */
+    { 0x3E, 0x41, 0x5D, 0x59, 0x4E }, /* '@' */
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C }, /* 'A' */
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, /* 'B' */
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, /* 'C' */
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, /* 'D' */
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 }, /* 'E' */
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, /* 'F' */
+    { 0x3E, 0x41, 0x41, 0x51, 0x73 }, /* 'G' */
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, /* 'H' */
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 }, /* 'I' */
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, /* 'J' */
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 }, /* 'K' */
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, /* 'L' */
+    { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, /* 'M' */
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, /* 'N' */
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E }, /* 'O' */
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, /* 'P' */
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E }, /* 'Q' */
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, /* 'R' */
+    { 0x26, 0x49, 0x49, 0x49, 0x32 }, /* 'S' */
+    { 0x03, 0x01, 0x7F, 0x01, 0x03 }, /* 'T' */
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }, /* 'U' */
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, /* 'V' */
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F }, /* 'W' */
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, /* 'X' */
+    { 0x03, 0x04, 0x78, 0x04, 0x03 }, /* 'Y' */
+    { 0x61, 0x59, 0x49, 0x4D, 0x43 }, /* 'Z' */
+    { 0x00, 0x7F, 0x41, 0x41, 0x41 }, /* '[' */
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, /* '\' */
+    { 0x00, 0x41, 0x41, 0x41, 0x7F }, /* ']' */
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, /* '^' */
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }  /* '_' */
+};
+
+/** Battery icons, empty to full. Characters 0x01..0x05 in the text.
+ */
+static const uint8_t g_battery[service::Overlay::BATTERY_LEVELS][FONT_COLUMNS] PROGMEM =
+{
+    { 0x7E, 0x42, 0x43, 0x42, 0x7E },
+    { 0x7E, 0x62, 0x63, 0x62, 0x7E },
+    { 0x7E, 0x72, 0x73, 0x72, 0x7E },
+    { 0x7E, 0x7A, 0x7B, 0x7A, 0x7E },
+    { 0x7E, 0x7E, 0x7F, 0x7E, 0x7E }
+};
+
+/** Pixel per character cell in the frame */
+static const uint8_t CELL_WIDTH =
+    service::Overlay::GLYPH_WIDTH * service::Overlay::SCALE;
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace service
+{
+    Overlay::Overlay() :
+        m_base(nullptr),
+        m_rowBytes(0u),
+        m_col(0u),
+        m_row(0u),
+        m_left(0u),
+        m_right(0u),
+        m_top(0u),
+        m_bottom(0u),
+        m_fg(0u),
+        m_bg(1u),
+        m_len(0u)
+    {
+    }
+
+    void Overlay::begin(
+        uint16_t frameWidth, uint16_t frameHeight,
+        uint16_t x, uint16_t y,
+        const char * text,
+        uint8_t foreground, uint8_t background)
+    {
+        m_len = 0u;
+        while ((m_len < MAX_TEXT) && ('\0' != text[m_len]))
+        {
+            m_text[m_len] = text[m_len];
+            ++m_len;
+        }
+
+        m_fg = foreground;
+        m_bg = background;
+        m_rowBytes = frameWidth >> 1u;
+        m_col = 0u;
+        m_row = 0u;
+
+        /* clip box into frame, empty box if outside */
+        m_left = x >> 1u;
+        m_right = m_left + (((uint16_t)m_len * CELL_WIDTH) >> 1u);
+        m_top = y;
+        m_bottom = y + GLYPH_HEIGHT * SCALE;
+
+        if (m_left > m_rowBytes)
+        {
+            m_left = m_rowBytes;
+        }
+        if (m_right > m_rowBytes)
+        {
+            m_right = m_rowBytes;
+        }
+        if (m_bottom > frameHeight)
+        {
+            m_bottom = frameHeight;
+        }
+    }
+
+    void Overlay::setBase(PixelSource& base)
+    {
+        m_base = &base;
+    }
+
+    uint16_t Overlay::next(uint8_t& value, uint16_t max)
+    {
+        uint16_t end(m_rowBytes);   /* end of pass through section */
+        bool box(false);
+
+        if ((m_top <= m_row) && (m_row < m_bottom))
+        {
+            if (m_col < m_left)
+            {
+                end = m_left;
+            }
+            else if (m_col < m_right)
+            {
+                end = m_right;
+                box = true;
+            }
+        }
+
+        uint16_t run(end - m_col);
+        if (run > max)
+        {
+            run = max;
+        }
+
+        if (box)
+        {
+            run = render(value, run);
+            skip(run);
+        }
+        else
+        {
+            run = m_base->next(value, run);
+        }
+
+        m_col += run;
+        if (m_rowBytes == m_col)
+        {
+            m_col = 0u;
+            ++m_row;
+        }
+
+        return run;
+    }
+
+    char Overlay::batteryIcon(uint8_t level)
+    {
+        if (level >= BATTERY_LEVELS)
+        {
+            level = BATTERY_LEVELS - 1u;
+        }
+        return (char)(level + 1u);
+    }
+
+    uint16_t Overlay::render(uint8_t& value, uint16_t max) const
+    {
+        const uint8_t row((uint8_t)(m_row - m_top));
+        uint16_t px((m_col - m_left) << 1u);
+        uint16_t run(1u);
+
+        value = (uint8_t)((pixel(px, row) << 4) | pixel(px + 1u, row));
+
+        /* merge identical bytes into one run */
+        for (px += 2u; run < max; ++run, px += 2u)
+        {
+            if (value != (uint8_t)((pixel(px, row) << 4) | pixel(px + 1u, row)))
+            {
+                break;
+            }
+        }
+
+        return run;
+    }
+
+    void Overlay::skip(uint16_t count)
+    {
+        uint8_t value;
+
+        while (0u != count)
+        {
+            const uint16_t run(m_base->next(value, count));
+
+            if (0u == run)
+            {
+                break;  /* end of image data */
+            }
+            count -= run;
+        }
+    }
+
+    uint8_t Overlay::pixel(uint16_t px, uint8_t row) const
+    {
+        const char c(m_text[px / CELL_WIDTH]);
+        const uint8_t column((uint8_t)((px % CELL_WIDTH) / SCALE));
+        const uint8_t * glyph(nullptr);
+
+        if (column >= FONT_COLUMNS)
+        {
+            return m_bg;    /* spacing column */
+        }
+
+        if ((0 < c) && (c <= (char)BATTERY_LEVELS))
+        {
+            glyph = g_battery[c - 1];
+        }
+        else if (('a' <= c) && (c <= 'z'))
+        {
+            glyph = g_font[c - 'a' + 'A' - FONT_FIRST];
+        }
+        else if ((FONT_FIRST <= c) && (c <= FONT_LAST))
+        {
+            glyph = g_font[c - FONT_FIRST];
+        }
+        else
+        {
+            return m_bg;
+        }
+
+        const uint8_t bits(pgm_read_byte(&glyph[column]));
+
+        return (bits & (1u << (row / SCALE))) ? m_fg : m_bg;
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OVERLAY_H_INCLUDED
+#define OVERLAY_H_INCLUDED
+
+#include <stdint.h>
+
+#include "service/Display/PixelSource.h"
+
+namespace service
+{
+    /**
+     * @brief Status text overlay on streamed images
+     *
+     * Wraps the pixel source of the image. Bytes inside the text box
+     * are replaced by the rendered text, all others pass unchanged.
+     * The text is rendered on the fly per output byte from a PROGMEM
+     * 5x7 font, no frame buffer is needed.
+     *
+     * Supported characters are ASCII 0x20..0x5F (lower case letters
+     * print upper case) and the battery icons from batteryIcon().
+     */
+    class Overlay : public PixelSource
+    {
+        public:
+
+            static const uint8_t MAX_TEXT = 32u;     /**< max text length      */
+            static const uint8_t GLYPH_WIDTH = 6u;   /**< pixel per character  */
+            static const uint8_t GLYPH_HEIGHT = 8u;  /**< rows per character   */
+            static const uint8_t SCALE = 2u;         /**< pixel magnification  */
+            static const uint8_t BATTERY_LEVELS = 5u;/**< battery icon levels  */
+
+            Overlay();
+
+            /**
+             * @brief Start a frame with the text box at the given position
+             *
+             * The box gets clipped at the right and bottom frame border.
+             *
+             * @param frameWidth frame width in pixel
+             * @param frameHeight frame height in pixel
+             * @param x          left column of text box (even)
+             * @param y          top row of text box
+             * @param text       text to show, truncated to MAX_TEXT
+             * @param foreground text color index
+             * @param background box color index
+             */
+            void begin(
+                uint16_t frameWidth, uint16_t frameHeight,
+                uint16_t x, uint16_t y,
+                const char * text,
+                uint8_t foreground, uint8_t background);
+
+            /**
+             * @brief Set the source of the image below the overlay
+             *
+             * @param base image pixel source
+             */
+            void setBase(PixelSource& base);
+
+            /**
+             * @brief Get the next run of image data with overlay
+             */
+            virtual uint16_t next(uint8_t& value, uint16_t max) override;
+
+            /**
+             * @brief Get the character showing a battery icon
+             *
+             * @param level fill level 0 (empty)..BATTERY_LEVELS-1 (full)
+             * @return char icon character for the text
+             */
+            static char batteryIcon(uint8_t level);
+
+        private:
+            /** Get run of identical rendered text bytes, up to max */
+            uint16_t render(uint8_t& value, uint16_t max) const;
+
+            /** Drop count bytes of the base source */
+            void skip(uint16_t count);
+
+            /** Get color index of a text box pixel */
+            uint8_t pixel(uint16_t px, uint8_t row) const;
+
+            PixelSource * m_base;        /**< image below the overlay     */
+            uint16_t m_rowBytes;         /**< bytes per frame row         */
+            uint16_t m_col;              /**< byte column in current row  */
+            uint16_t m_row;              /**< current frame row           */
+            uint16_t m_left;             /**< first box byte column       */
+            uint16_t m_right;            /**< byte column after box       */
+            uint16_t m_top;              /**< first box row               */
+            uint16_t m_bottom;           /**< row after box               */
+            uint8_t  m_fg;               /**< text color                  */
+            uint8_t  m_bg;               /**< box color                   */
+            char     m_text[MAX_TEXT];   /**< text, not terminated        */
+            uint8_t  m_len;              /**< text length                 */
+    };
+}
+
+#endif /* OVERLAY_H_INCLUDED */
@@ -36,6 +36,7 @@
 #include "hal/Cpu/Cpu.h"
 #include "hal/Gpio/Gpio.h"
 #include "hal/Spi/Spi.h"
+#include "hal/UsartSpi/UsartSpi.h"
 #include "hal/Timer/TickTimer.h"
 #include "hal/Uart/Uart.h"
 #include "hal/Timer/WakeUpTimer.h"
@@ -43,6 +44,9 @@
 
 extern "C" void disk_timerproc (void);
 
+/** wakeup timer time at suspend(), to adjust the tick timer at resume() */
+static uint32_t g_suspend_ms = 0ul;
+
 namespace service
 {
     void Power::halt(void)
@@ -81,38 +85,49 @@ namespace service
          }
      }
 
-    void Power::suspend()
+    void Power::suspend(bool keepSdCard)
     {
         /* external modules off */
-        service::Power::disable(service::Power::POW_SDCARD);
+        if (!keepSdCard)
+        {
+            service::Power::disable(service::Power::POW_SDCARD);
+        }
         service::Power::disable(service::Power::POW_DISPLAY);
 
         hal::Uart::get().close();
+        hal::Cpu::setClock(hal::Cpu::CLK_NORMAL);
 
         /* disable on chip devices */
         hal::Adc::disable();
         hal::Spi::disable();
+#if WITH_USART_DISPLAY != 0
+        hal::UsartSpi::disable();
+#endif
 
-        /* enable wakeup timer */
-        hal::WakeUpTimer::init();
+        /* the wakeup timer keeps running, it is the time base */
         hal::WakeUpTimer::enable();
+        g_suspend_ms = hal::WakeUpTimer::getElapsed_ms();
 
         hal::TickTimer::disable(); /* disable at last to loose less ticks*/
     }
 
-    void Power::resume(uint32_t adjustTimeMs)
+    void Power::resume(void)
     {
+        hal::WakeUpTimer::enable();
+
         hal::TickTimer::init();
         hal::TickTimer::enable(disk_timerproc);
-        hal::TickTimer::adjustMillies(adjustTimeMs);
-
-        /* disable wakeup timer */
-        hal::WakeUpTimer::disable();
+        hal::TickTimer::adjustMillies(
+            hal::WakeUpTimer::getElapsed_ms() - g_suspend_ms);
 
         /* turn on onchip devices */
 
         hal::Spi::init();
         hal::Spi::enable();
+#if WITH_USART_DISPLAY != 0
+        hal::UsartSpi::init();
+        hal::UsartSpi::enable();
+#endif
         hal::Adc::enable();
 
         DEBUG_INIT();
@@ -122,6 +137,81 @@ namespace service
         hal::Cpu::enterIdle(1);
     }
 
+    bool Power::boost(void)
+    {
+#if WITH_FAST_CLOCK != 0
+        if (hal::Cpu::CLK_FAST == hal::Cpu::getClock())
+        {
+            return true;
+        }
+
+        if (getSupplyVoltage_mV() < BOOST_MIN_MV)
+        {
+            return false;
+        }
+
+        hal::Uart::get().close();
+        hal::Cpu::setClock(hal::Cpu::CLK_FAST);
+
+        /* reprogram clock dependent dividers */
+        hal::Adc::enable();
+        DEBUG_INIT();
+
+        return (hal::Cpu::CLK_FAST == hal::Cpu::getClock());
+#else
+        return false;
+#endif
+    }
+
+    void Power::sleep(uint32_t ms)
+    {
+        hal::WakeUpTimer::setAlarm(ms);
+
+        /* Check the alarm with interrupts off, so that an alarm
+         * between check and sleep still wakes us up immediately.
+         */
+        hal::Cpu::irqDisable();
+        while (!hal::WakeUpTimer::isAlarm())
+        {
+            hal::Cpu::enterPowerSave();
+            hal::Cpu::irqDisable();
+        }
+        hal::Cpu::irqEnable();
+    }
+
+    bool Power::sleepWhileDisplayBusy(uint16_t tmo_ms)
+    {
+        hal::Uart::get().close();
+
+        const uint32_t start(hal::WakeUpTimer::getElapsed_ms());
+        hal::WakeUpTimer::setAlarm(tmo_ms);
+        hal::Gpio::enableDispBusyIrq();
+        hal::TickTimer::disable();
+
+        /* Check pin and alarm with interrupts off, so that a change
+         * between check and sleep still wakes us up immediately.
+         */
+        hal::Cpu::irqDisable();
+        while ((false == hal::Gpio::getDispBusy()) &&
+               (!hal::WakeUpTimer::isAlarm()))
+        {
+            hal::Cpu::enterPowerSave();
+            hal::Cpu::irqDisable();
+        }
+        hal::Cpu::irqEnable();
+
+        hal::Gpio::disableDispBusyIrq();
+        const uint32_t elapsed(hal::WakeUpTimer::getElapsed_ms() - start);
+
+        hal::TickTimer::init();
+        hal::TickTimer::enable(disk_timerproc);
+        hal::TickTimer::adjustMillies(elapsed);
+
+        DEBUG_INIT();
+
+        return hal::Gpio::getDispBusy();
+    }
+
     void Power::setCalibrationVoltages(
                 uint16_t refVoltage_mV,
                 uint16_t supVoltage_mv)
@@ -38,6 +38,8 @@
 
 #include "hal/Adc/Adc.h"
 
+#include "service/Rtc/Rtc.h"
+
 namespace service
 {
     class Power
@@ -62,22 +64,16 @@ namespace service
         static void halt(void);
 
         /**
-         * @brief sleep CPU
+         * @brief Sleep CPU in power save for the given time
          *
-         */
-        static void sleep(void)
-        {
-            hal::Cpu::enterPowerSave();
-        }
-
-        /** Get sleep duration in ms
+         * Requires suspend(). The wakeup timer interrupts every
+         * WAKEUP_INTERVAl_MS count down the time without returning
+         * here, so the CPU goes back to sleep right after the
+         * interrupt handler.
          *
-         * In our case we are woken up by the WakeTimer, get its max interval.
+         * @param ms time to sleep, resolution 31.25ms
          */
-        static uint16_t getSleepDurationMs()
-        {
-            return hal::WakeUpTimer::WAKEUP_INTERVAl_MS;
-        }
+        static void sleep(uint32_t ms);
 
         /**
          * @brief Enter idle mode for given timer ticks (1tick = 10ms)
@@ -92,33 +88,67 @@ namespace service
         /**
          * @brief Reboot system
          *
+         * The real time clock keeps its time over the reboot.
          */
         static void reboot(void)
         {
+            Rtc::save();
             hal::Cpu::reset();
         }
 
         /**
          * @brief Resume power for devices
          *
-         * @param adjustTimeMs Sleep time to adjust millis count
+         * The tick timer millis count gets adjusted by the time since
+         * suspend(), as measured by the wakeup timer.
          */
-        static void resume(uint32_t adjustTimeMs);
+        static void resume(void);
 
         /**
          * @brief Suspend power
          *
+         * @param keepSdCard true to leave the SD card powered in its
+         *                   idle state, @see FileIo::enable
          */
-        static void suspend(void);
+        static void suspend(bool keepSdCard = false);
+
+        /**
+         * @brief Switch to the fast CPU clock profile for busy phases
+         *
+         * Only switches if the supply voltage allows 8 Mhz operation,
+         * suspend() drops back to the normal clock. Finishing the update
+         * at double speed saves more energy than the higher current
+         * costs.
+         *
+         * @return true  running at the fast clock
+         * @return false clock unchanged
+         */
+        static bool boost(void);
+
+        /**
+         * @brief Sleep in power save while the display is busy
+         *
+         * The tick timer is stopped, the CPU wakes up on the display
+         * busy pin change or on a wakeup timer alarm at the timeout.
+         * The uptime gets adjusted by the time slept.
+         *
+         * @param tmo_ms maximum time to sleep
+         * @return true  display is idle
+         * @return false timeout, display still busy
+         */
+        static bool sleepWhileDisplayBusy(uint16_t tmo_ms);
 
         /**
          * @brief Get uptime since power up in milliseconds
          *
+         * Counted by the crystal clocked wakeup timer, including sleep
+         * phases. Resolution is 31.25ms.
+         *
          * @return uint32_t
          */
         static uint32_t uptime_mS(void)
         {
-            return hal::TickTimer::getMillis();
+            return hal::WakeUpTimer::getElapsed_ms();
         }
 
         /**
@@ -147,6 +177,9 @@ namespace service
                 uint16_t supVoltage_mv);
 
         private:
+            /** Minimum supply voltage for the fast clock profile */
+            static const uint16_t BOOST_MIN_MV = 2700u;
+
             Power(const Power&);
             Power& operator=(const Power&);
 
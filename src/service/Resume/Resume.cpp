@@ -0,0 +1,143 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Resume/Resume.h"
+
+#include "hal/Eeprom/Eeprom.h"
+#include "service/Debug/Debug.h"
+#include "service/Crc/Crc.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/** Number of slots in the EEPROM ring
+ */
+static const uint8_t SLOTS = 32u;
+
+/**
+ * @brief EEPROM slot layout
+ */
+struct Slot
+{
+    uint16_t sequence;                  /**< incremented per save      */
+    service::Resume::Position pos;      /**< saved position            */
+    uint8_t  crc8;                      /**< CRC8 over sequence + pos  */
+};
+
+/** Slot ring in EEPROM
+ */
+static Slot g_slots[SLOTS] EEMEM;
+
+static bool     g_scanned;   /**< g_current and g_sequence are valid */
+static bool     g_valid;     /**< a valid slot exists                */
+static uint8_t  g_current;   /**< slot with the newest position      */
+static uint16_t g_sequence;  /**< sequence number in g_current       */
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace service
+{
+    bool Resume::load(Position& pos)
+    {
+        Slot slot;
+
+        scan();
+
+        if (g_valid)
+        {
+            hal::Eeprom::read(&slot, &g_slots[g_current], sizeof(slot));
+            pos = slot.pos;
+        }
+
+        return g_valid;
+    }
+
+    void Resume::save(const Position& pos)
+    {
+        Slot slot;
+
+        scan();
+
+        if (g_valid)
+        {
+            g_current = (uint8_t)((g_current + 1u) % SLOTS);
+            ++g_sequence;
+        }
+        else
+        {
+            g_current = 0u;
+            g_sequence = 0u;
+        }
+
+        slot.sequence = g_sequence;
+        slot.pos = pos;
+        slot.crc8 = service::Crc::crc8(&slot, offsetof(Slot, crc8));
+
+        hal::Eeprom::update(&g_slots[g_current], &slot, sizeof(slot));
+        g_valid = true;
+
+        DEBUG_LOGP("Resume slot %d seq %u\r\n", g_current, g_sequence);
+    }
+
+    void Resume::scan(void)
+    {
+        if (g_scanned)
+        {
+            return;
+        }
+
+        for (uint8_t idx(0u); idx < SLOTS; ++idx)
+        {
+            Slot slot;
+
+            hal::Eeprom::read(&slot, &g_slots[idx], sizeof(slot));
+
+            /* sequence numbers of valid slots are less than SLOTS
+             * apart, a signed difference handles the wrap around
+             */
+            if ((slot.crc8 ==
+                    service::Crc::crc8(&slot, offsetof(Slot, crc8))) &&
+                ((!g_valid) || (0 < (int16_t)(slot.sequence - g_sequence))))
+            {
+                g_valid = true;
+                g_current = idx;
+                g_sequence = slot.sequence;
+            }
+        }
+
+        g_scanned = true;
+    }
+}
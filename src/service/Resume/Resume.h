@@ -0,0 +1,92 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RESUME_H_INCLUDED
+#define RESUME_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Playlist position kept in EEPROM over resets
+     *
+     * Each save goes into the next slot of a ring in EEPROM, so a
+     * single location doesn't wear out with an update every interval.
+     * A slot holds a sequence number and a CRC8. The valid slot with
+     * the highest sequence number is the current one. A reset while
+     * writing leaves the previous slot intact.
+     */
+    class Resume
+    {
+        public:
+
+            /**
+             * @brief Position to resume from
+             */
+            struct Position
+            {
+                uint32_t vsn;       /**< volume serial number of card  */
+                uint16_t index;     /**< image index file entry        */
+                uint32_t dptr;      /**< directory offset, 0 = start   */
+                uint32_t cluster;   /**< directory cluster at dptr     */
+                uint32_t sector;    /**< directory sector at dptr      */
+                uint8_t  album;     /**< album the position belongs to */
+            };
+
+            /**
+             * @brief Load the last saved position
+             *
+             * @param[out] pos saved position
+             * @return true  position loaded
+             * @return false nothing saved yet
+             */
+            static bool load(Position& pos);
+
+            /**
+             * @brief Save a position
+             *
+             * @param pos position to save
+             */
+            static void save(const Position& pos);
+
+        private:
+            /** Find the current slot */
+            static void scan(void);
+
+            Resume();
+            Resume(const Resume&);
+            Resume& operator=(const Resume&);
+    };
+}
+
+#endif /* RESUME_H_INCLUDED */
@@ -0,0 +1,183 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Rtc/Rtc.h"
+#include "service/Debug/Debug.h"
+#include "service/Crc/Crc.h"
+#include "hal/Timer/WakeUpTimer.h"
+#include "hal/Cpu/Cpu.h"
+#include "hal/Eeprom/Eeprom.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/**
+ * @brief Clock state, the time at a wakeup timer count
+ *
+ * The wakeup timer restarts with every reset, so the time lives in
+ * .noinit RAM over the watchdog reset of Power::reboot(). Other resets
+ * lose the time since the last save(), the state gets dropped then.
+ */
+struct RtcState
+{
+    uint32_t time;          /**< seconds at counts                  */
+    uint32_t counts;        /**< wakeup timer counts at time        */
+    int32_t  ppmRest;       /**< correction below one count, in ppm */
+    uint8_t  fraction;      /**< timer counts beyond time           */
+    uint8_t  valid;         /**< time got set                       */
+    uint8_t  crc8;          /**< CRC8 over all members above        */
+};
+
+static RtcState g_rtc __attribute__((section(".noinit")));
+
+/** Last applied configuration time, kept over a power loss */
+static uint32_t g_configTime EEMEM;
+
+/** calibration in ppm */
+static int16_t g_ppm = 0;
+
+/** CRC8 of the clock state members in front of crc8
+ *
+ * @return uint8_t CRC8
+ */
+static inline uint8_t stateCrc(void)
+{
+    return service::Crc::crc8(&g_rtc, offsetof(RtcState, crc8));
+}
+
+/** Get the calibrated timer counts since the last save
+ *
+ * Short sleeps correct less than one count, the rest carries over to
+ * the next save so that it adds up.
+ *
+ * @param now  wakeup timer counts
+ * @param rest correction below one count in ppm, may be NULL
+ * @return uint32_t counts including fraction
+ */
+static uint32_t calibratedCounts(uint32_t now, int32_t * rest)
+{
+    const uint32_t delta(now - g_rtc.counts);
+    const int64_t correction(
+        ((int64_t)delta * g_ppm) + g_rtc.ppmRest);
+
+    if (NULL != rest)
+    {
+        *rest = (int32_t)(correction % 1000000);
+    }
+
+    return delta + (uint32_t)(int32_t)(correction / 1000000) + g_rtc.fraction;
+}
+
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+
+namespace service
+{
+    void Rtc::init(void)
+    {
+        if ((!hal::Cpu::isSoftReset()) || (g_rtc.crc8 != stateCrc()))
+        {
+            memset(&g_rtc, 0, sizeof(g_rtc));
+        }
+
+        /* the wakeup timer restarted with the reset */
+        g_rtc.counts = hal::WakeUpTimer::getCounts();
+        g_rtc.crc8 = stateCrc();
+
+        DEBUG_LOGP("rtc: %lu (%u)\r\n", g_rtc.time, g_rtc.valid);
+    }
+
+    void Rtc::setCalibration(int16_t ppm)
+    {
+        save();     /* time so far with the previous calibration */
+        g_ppm = ppm;
+    }
+
+    void Rtc::setTime(uint32_t seconds)
+    {
+        g_rtc.time = seconds;
+        g_rtc.counts = hal::WakeUpTimer::getCounts();
+        g_rtc.fraction = 0u;
+        g_rtc.ppmRest = 0;
+        g_rtc.valid = 1u;
+        g_rtc.crc8 = stateCrc();
+    }
+
+    void Rtc::setConfigTime(uint32_t seconds)
+    {
+        uint32_t applied;
+
+        hal::Eeprom::read(&applied, &g_configTime, sizeof(applied));
+
+        if ((0ul != seconds) && (seconds != applied))
+        {
+            DEBUG_LOGP("rtc: set %lu\r\n", seconds);
+
+            setTime(seconds);
+            hal::Eeprom::update(&g_configTime, &seconds, sizeof(seconds));
+        }
+    }
+
+    bool Rtc::isValid(void)
+    {
+        return 0u != g_rtc.valid;
+    }
+
+    uint32_t Rtc::getTime(void)
+    {
+        return g_rtc.time + (calibratedCounts(
+            hal::WakeUpTimer::getCounts(), NULL) /
+            hal::WakeUpTimer::COUNTS_PER_SECOND);
+    }
+
+    uint16_t Rtc::getMinuteOfDay(void)
+    {
+        return (uint16_t)((getTime() % SECONDS_PER_DAY) / 60u);
+    }
+
+    void Rtc::save(void)
+    {
+        const uint32_t now(hal::WakeUpTimer::getCounts());
+        const uint32_t counts(calibratedCounts(now, &g_rtc.ppmRest));
+
+        g_rtc.time += counts / hal::WakeUpTimer::COUNTS_PER_SECOND;
+        g_rtc.fraction = (uint8_t)(counts % hal::WakeUpTimer::COUNTS_PER_SECOND);
+        g_rtc.counts = now;
+        g_rtc.crc8 = stateCrc();
+    }
+}
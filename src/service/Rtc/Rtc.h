@@ -0,0 +1,129 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RTC_H_INCLUDED
+#define RTC_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Real time clock based on the 32.768kHz wakeup timer
+     *
+     * The time counts in seconds since 2000-01-01 00:00 local time. The
+     * wakeup timer runs through sleep and awake phases, so no estimated
+     * sleep durations enter the time. A calibration in ppm corrects the
+     * crystal frequency error.
+     *
+     * The clock state is kept in uninitialized RAM. It survives the
+     * watchdog reset of Power::reboot(), any other reset leaves the
+     * clock unset.
+     */
+    class Rtc
+    {
+        public:
+            /** Seconds per day */
+            static const uint32_t SECONDS_PER_DAY = 86400ul;
+
+            /**
+             * @brief Restore the clock after a reset
+             *
+             * Requires the running wakeup timer, @see Power::resume.
+             */
+            static void init(void);
+
+            /**
+             * @brief Set the crystal calibration
+             *
+             * @param ppm parts per million to add, positive if the clock
+             *            runs slow, negative if it runs fast
+             */
+            static void setCalibration(int16_t ppm);
+
+            /**
+             * @brief Set the time
+             *
+             * @param seconds seconds since 2000-01-01 00:00
+             */
+            static void setTime(uint32_t seconds);
+
+            /**
+             * @brief Set the time from a configured value
+             *
+             * The configuration gets read on every start. A value is
+             * applied only once, so that a reboot or a power loss does
+             * not set the clock back to the time the value was written.
+             * The last applied value is kept in EEPROM.
+             *
+             * @param seconds seconds since 2000-01-01 00:00, 0 to keep
+             *                the time
+             */
+            static void setConfigTime(uint32_t seconds);
+
+            /**
+             * @brief Check if the time got set since power on
+             *
+             * @return true  time is valid
+             * @return false time counts from power on
+             */
+            static bool isValid(void);
+
+            /**
+             * @brief Get the time
+             *
+             * @return uint32_t seconds since 2000-01-01 00:00
+             */
+            static uint32_t getTime(void);
+
+            /**
+             * @brief Get the minute of the day
+             *
+             * @return uint16_t 0..1439
+             */
+            static uint16_t getMinuteOfDay(void);
+
+            /**
+             * @brief Store the time in uninitialized RAM
+             *
+             * Call before a reboot and on each sleep, the time passed
+             * since the last save is lost on a reset.
+             */
+            static void save(void);
+
+        private:
+            Rtc(const Rtc&);
+            Rtc& operator=(const Rtc&);
+    };
+}
+
+#endif /* RTC_H_INCLUDED */
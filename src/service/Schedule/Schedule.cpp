@@ -0,0 +1,146 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Schedule/Schedule.h"
+
+/** Seconds per day */
+static const uint32_t SECONDS_PER_DAY = 86400ul;
+
+/**
+ * @brief Get the seconds from one second of the day to a minute of day
+ *
+ * @param second second of the day
+ * @param minute target minute of the day
+ * @return uint32_t seconds, the next day if the minute is not later today
+ */
+static uint32_t secondsUntil(uint32_t second, uint16_t minute)
+{
+    const uint32_t target((uint32_t)minute * 60u);
+
+    return (second < target) ?
+        target - second : SECONDS_PER_DAY - second + target;
+}
+
+/**
+ * @brief Get the seconds until the next update time of a table
+ *
+ * @param table  schedule table
+ * @param count  used update times, at least 1
+ * @param second second of the day
+ * @return uint32_t seconds, at most one day
+ */
+static uint32_t nextUpdate(
+    const service::Schedule::Table& table, uint8_t count, uint32_t second)
+{
+    uint32_t result(SECONDS_PER_DAY);
+
+    for (uint8_t idx(0u); idx < count; ++idx)
+    {
+        const uint32_t delta(secondsUntil(second, (uint16_t)(
+            table.times[idx] % service::Schedule::MINUTES_PER_DAY)));
+
+        if (delta < result)
+        {
+            result = delta;
+        }
+    }
+
+    return result;
+}
+
+namespace service
+{
+    bool Schedule::inRange(uint16_t minute, uint16_t start, uint16_t end)
+    {
+        bool result(true);
+
+        if (start < end)
+        {
+            result = (start <= minute) && (minute < end);
+        }
+        else if (end < start)
+        {
+            result = (start <= minute) || (minute < end); /* over midnight */
+        }
+
+        return result;
+    }
+
+    uint32_t Schedule::getSleepSeconds(
+        const Table& table, uint32_t second, uint16_t interval,
+        uint16_t stretch)
+    {
+        const uint8_t count(
+            (MAX_TIMES < table.count) ? MAX_TIMES : (uint8_t)table.count);
+
+        second %= SECONDS_PER_DAY;
+        uint32_t result((uint32_t)interval * 60u);
+
+        if (0u != count)
+        {
+            result = nextUpdate(table, count, second);
+        }
+
+        if (100u < stretch)
+        {
+            result = (result / 100u) * stretch +
+                ((result % 100u) * stretch) / 100u;
+
+            if (0u != count)
+            {
+                /* skip update times until the stretched time passed */
+                result += nextUpdate(table, count,
+                    (second + result - 1u) % SECONDS_PER_DAY) - 1u;
+            }
+        }
+
+        /* move the wakeup out of the quiet hours */
+        if (table.quietStart != table.quietEnd)
+        {
+            const uint32_t wakeup((second + result) % SECONDS_PER_DAY);
+
+            if (inRange((uint16_t)(wakeup / 60u),
+                        table.quietStart, table.quietEnd))
+            {
+                result += secondsUntil(wakeup,
+                    (uint16_t)(table.quietEnd % MINUTES_PER_DAY));
+            }
+        }
+
+        if (MAX_SLEEP_SECONDS < result)
+        {
+            result = MAX_SLEEP_SECONDS;
+        }
+
+        return (0ul == result) ? 1ul : result;
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SCHEDULE_H_INCLUDED
+#define SCHEDULE_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Time of day update schedule
+     *
+     * Computes the sleep time until the next update from fixed update
+     * times or an interval, and moves updates out of the quiet hours.
+     * Times are minutes of the day (0..1439), ranges with end before
+     * start wrap over midnight.
+     */
+    class Schedule
+    {
+        public:
+            /** Maximum number of fixed update times */
+            static const uint8_t MAX_TIMES = 4u;
+
+            /** Minutes per day */
+            static const uint16_t MINUTES_PER_DAY = 1440u;
+
+            /** Longest sleep, keeps the time in ms within 32 bit */
+            static const uint32_t MAX_SLEEP_SECONDS = 4000000ul;
+
+            /**
+             * @brief Schedule table, as stored in the parameter file
+             */
+            struct Table
+            {
+                uint16_t quietStart;        /**< quiet hours start         */
+                uint16_t quietEnd;          /**< quiet hours end, = start: none */
+                uint16_t count;             /**< used update times         */
+                uint16_t times[MAX_TIMES];  /**< update times              */
+            };
+
+            /**
+             * @brief Check if a minute is inside a time of day range
+             *
+             * @param minute minute of day
+             * @param start  range start, included
+             * @param end    range end, excluded, equal to start means
+             *               all day
+             * @return true  minute is in the range
+             * @return false minute is outside
+             */
+            static bool inRange(uint16_t minute, uint16_t start, uint16_t end);
+
+            /**
+             * @brief Get the time to sleep until the next update
+             *
+             * Sleeps until the next update time of the table, or for
+             * the interval if the table has none. A stretch above 100%
+             * lengthens the interval, or skips update times until the
+             * stretched time passed. An update inside the quiet hours
+             * moves to their end.
+             *
+             * @param table    schedule table
+             * @param second   current second of the day
+             * @param interval update interval in minutes
+             * @param stretch  sleep time stretch in percent
+             * @return uint32_t seconds to sleep, 1..MAX_SLEEP_SECONDS
+             */
+            static uint32_t getSleepSeconds(
+                const Table& table, uint32_t second, uint16_t interval,
+                uint16_t stretch = 100u);
+
+        private:
+            Schedule();
+            Schedule(const Schedule&);
+            Schedule& operator=(const Schedule&);
+    };
+}
+
+#endif /* SCHEDULE_H_INCLUDED */
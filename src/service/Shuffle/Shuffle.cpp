@@ -0,0 +1,79 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "service/Shuffle/Shuffle.h"
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+namespace service
+{
+    Shuffle::Shuffle() :
+        m_count(0u), m_mask(0u), m_mult(1u), m_inc(1u)
+    {
+    }
+
+    void Shuffle::begin(uint16_t count, uint16_t seed)
+    {
+        m_count = count;
+
+        /* smallest power of two holding all elements */
+        uint32_t modulus(1u);
+        while (modulus < count)
+        {
+            modulus <<= 1u;
+        }
+        m_mask = (uint16_t)(modulus - 1u);
+
+        /* a = 5 mod 8 mixes better than a = 1, which is only a rotation */
+        m_mult = (8u <= modulus) ?
+            (uint16_t)(((uint16_t)(seed << 3u) | 5u) & m_mask) : 1u;
+        m_inc = (uint16_t)(((seed >> 8u) << 1u | 1u) & m_mask);
+    }
+
+    uint16_t Shuffle::next(uint16_t pos) const
+    {
+        if (0u == m_count)
+        {
+            return 0u;
+        }
+
+        uint16_t value((uint16_t)(pos & m_mask));
+
+        do
+        {
+            value = (uint16_t)(((uint32_t)m_mult * value + m_inc) & m_mask);
+        } while (value >= m_count);
+
+        return value;
+    }
+}
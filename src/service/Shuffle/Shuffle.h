@@ -0,0 +1,92 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHUFFLE_H_INCLUDED
+#define SHUFFLE_H_INCLUDED
+
+#include <stdint.h>
+
+namespace service
+{
+    /**
+     * @brief Random play order without a list in RAM
+     *
+     * A linear congruential generator x' = (a * x + c) mod m with m a
+     * power of two, c odd and a = 1 mod 4 visits every value below m
+     * once per period (Hull-Dobell). Values >= count are skipped
+     * (cycle walking), which leaves a permutation of 0..count-1.
+     *
+     * The order only depends on count and seed, so the current
+     * position is all that needs to be kept over sleeps and resets.
+     */
+    class Shuffle
+    {
+        public:
+
+            Shuffle();
+
+            /**
+             * @brief Set up the permutation
+             *
+             * @param count number of elements, 0 disables shuffling
+             * @param seed  selects one of the possible orders
+             */
+            void begin(uint16_t count, uint16_t seed);
+
+            /**
+             * @brief Get the number of permuted elements
+             *
+             * @return uint16_t count given to begin()
+             */
+            uint16_t getCount(void) const
+            {
+                return m_count;
+            }
+
+            /**
+             * @brief Get the position following pos in the permutation
+             *
+             * @param pos current position, values >= count are
+             *            mapped into the permutation
+             * @return uint16_t next position (0 if count is 0)
+             */
+            uint16_t next(uint16_t pos) const;
+
+        private:
+            uint16_t m_count;   /**< number of elements      */
+            uint16_t m_mask;    /**< generator modulus - 1   */
+            uint16_t m_mult;    /**< multiplier a            */
+            uint16_t m_inc;     /**< increment c             */
+    };
+}
+
+#endif /* SHUFFLE_H_INCLUDED */
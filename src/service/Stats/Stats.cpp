@@ -0,0 +1,130 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if WITH_STATS != 0
+
+#include "service/Stats/Stats.h"
+#include "service/Debug/Debug.h"
+#include "hal/Timer/TickTimer.h"
+
+/*******************************************************************************
+    Module statics
+*******************************************************************************/
+
+/** Statistics per phase */
+static service::Stats::Entry g_entries[service::Stats::PHASE_COUNT];
+
+/** Start time per phase in ms, 0 if not started */
+static uint32_t g_start[service::Stats::PHASE_COUNT];
+
+/** Phase names for the report */
+static const char g_names[service::Stats::PHASE_COUNT][8] PROGMEM =
+{
+    "init", "sdcard", "select", "stream", "refresh", "update", "sleep"
+};
+
+
+/*******************************************************************************
+    Implementation
+*******************************************************************************/
+
+namespace service
+{
+    void Stats::begin(Phase phase)
+    {
+        /* 0 marks an idle phase, avoid it as start time */
+        const uint32_t now(hal::TickTimer::getMillis());
+        g_start[phase] = (0ul == now) ? 1ul : now;
+    }
+
+    void Stats::end(Phase phase)
+    {
+        if (0ul == g_start[phase])
+        {
+            return;
+        }
+
+        const uint32_t duration(hal::TickTimer::getMillis() - g_start[phase]);
+        Entry& entry(g_entries[phase]);
+
+        g_start[phase] = 0ul;
+
+        if ((0u == entry.count) || (duration < entry.min))
+        {
+            entry.min = duration;
+        }
+        if (entry.max < duration)
+        {
+            entry.max = duration;
+        }
+        if (0xFFFFu != entry.count)
+        {
+            ++entry.count;
+        }
+
+        /* keep the average over overflows by halving sum and samples */
+        if ((entry.total + duration < entry.total) ||
+            (0xFFFFu == entry.samples))
+        {
+            entry.total /= 2u;
+            entry.samples /= 2u;
+        }
+        entry.total += duration;
+        ++entry.samples;
+    }
+
+    const Stats::Entry& Stats::get(Phase phase)
+    {
+        return g_entries[phase];
+    }
+
+    void Stats::report(void)
+    {
+#if WITH_DEBUG != 0
+        DEBUG_LOGP("phase   count min max avg [ms]\r\n");
+
+        for (uint8_t phase(0u); phase < PHASE_COUNT; ++phase)
+        {
+            const Entry& entry(g_entries[phase]);
+
+            if (0u != entry.count)
+            {
+                DEBUG_LOGP("%-8S%u %lu %lu %lu\r\n",
+                    g_names[phase], entry.count, entry.min, entry.max,
+                    entry.total / entry.samples);
+            }
+        }
+#endif
+    }
+}
+
+#endif //WITH_STATS
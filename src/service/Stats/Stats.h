@@ -0,0 +1,132 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef STATS_H_INCLUDED
+#define STATS_H_INCLUDED
+
+#include <stdint.h>
+
+/** Phase duration statistics (enabled with -D WITH_STATS=1) */
+
+#if WITH_STATS != 0
+
+#define STATS_BEGIN(phase)  service::Stats::begin(service::Stats::phase)
+#define STATS_END(phase)    service::Stats::end(service::Stats::phase)
+#define STATS_REPORT()      service::Stats::report()
+
+namespace service
+{
+    /**
+     * @brief Duration accounting of the update cycle phases
+     *
+     * Each phase gets timestamped with the tick timer millis count,
+     * which the wakeup timer keeps up to date over sleeps. Count,
+     * min, max and average duration are kept per phase since power
+     * on. Multiplied with the phase currents from the power test mode,
+     * they give the energy per phase.
+     */
+    class Stats
+    {
+        public:
+            /**
+             * @brief Measured phases
+             */
+            enum Phase
+            {
+                PHASE_INIT,     /**< power on until first update      */
+                PHASE_SDCARD,   /**< SD card init or resume           */
+                PHASE_SELECT,   /**< find, open and check next image  */
+                PHASE_STREAM,   /**< send image data to the display   */
+                PHASE_REFRESH,  /**< display refresh                  */
+                PHASE_UPDATE,   /**< whole update state               */
+                PHASE_SLEEP,    /**< sleep between updates            */
+                PHASE_COUNT
+            };
+
+            /**
+             * @brief Statistics of one phase, durations in ms
+             */
+            struct Entry
+            {
+                uint16_t count;     /**< measurements in total          */
+                uint32_t min;       /**< shortest duration              */
+                uint32_t max;       /**< longest duration               */
+                uint32_t total;     /**< sum of durations, halved with
+                                         count on overflow              */
+                uint16_t samples;   /**< durations in total             */
+            };
+
+            /**
+             * @brief Start measuring a phase
+             *
+             * @param phase phase
+             */
+            static void begin(Phase phase);
+
+            /**
+             * @brief Stop measuring a phase and account its duration
+             *
+             * Ignored if the phase did not begin.
+             *
+             * @param phase phase
+             */
+            static void end(Phase phase);
+
+            /**
+             * @brief Get the statistics of a phase
+             *
+             * @param phase phase
+             * @return const Entry& statistics
+             */
+            static const Entry& get(Phase phase);
+
+            /**
+             * @brief Print count, min, max and average of all phases
+             *        with DEBUG_LOGP
+             */
+            static void report(void);
+
+        private:
+            Stats(const Stats&);
+            Stats& operator=(const Stats&);
+    };
+}
+
+#else //WITH_STATS
+
+#define STATS_BEGIN(phase)
+#define STATS_END(phase)
+#define STATS_REPORT()
+
+#endif //WITH_STATS
+
+#endif /* STATS_H_INCLUDED */
@@ -36,6 +36,18 @@ extern void test_queue_generic(void);
 extern void test_queue_1_element(void);
 extern void test_statehandler_generic(void);
 extern void test_statehandler_transition(void);
+extern void test_rle_short_runs(void);
+extern void test_rle_odd_runs(void);
+extern void test_rle_long_runs(void);
+extern void test_window_placement(void);
+extern void test_window_limits(void);
+extern void test_pixel_solid(void);
+extern void test_pixel_pattern(void);
+extern void test_shuffle_permutation(void);
+extern void test_shuffle_limits(void);
+extern void test_schedule_interval(void);
+extern void test_schedule_times(void);
+extern void test_governor_curve(void);
 
 int main(int argc, char **argv)
  {
@@ -47,6 +59,24 @@ int main(int argc, char **argv)
     RUN_TEST(test_statehandler_generic);
     RUN_TEST(test_statehandler_transition);
 
+    RUN_TEST(test_rle_short_runs);
+    RUN_TEST(test_rle_odd_runs);
+    RUN_TEST(test_rle_long_runs);
+
+    RUN_TEST(test_window_placement);
+    RUN_TEST(test_window_limits);
+
+    RUN_TEST(test_pixel_solid);
+    RUN_TEST(test_pixel_pattern);
+
+    RUN_TEST(test_shuffle_permutation);
+    RUN_TEST(test_shuffle_limits);
+
+    RUN_TEST(test_schedule_interval);
+    RUN_TEST(test_schedule_times);
+
+    RUN_TEST(test_governor_curve);
+
     UNITY_END();
 
     return 0;
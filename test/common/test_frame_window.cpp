@@ -0,0 +1,164 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of FrameWindow */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "service/Image/FrameWindow.cpp"
+
+/** Pixel data from memory, one byte per run
+ */
+class MemorySource : public service::PixelSource
+{
+    public:
+        MemorySource(const uint8_t * data, uint16_t size) :
+            m_data(data), m_size(size), m_pos(0u)
+        {
+        }
+
+        virtual uint16_t next(uint8_t& value, uint16_t max) override
+        {
+            TEST_ASSERT_TRUE(0u < max);
+
+            if (m_pos == m_size)
+            {
+                return 0u;
+            }
+            value = m_data[m_pos++];
+            return 1u;
+        }
+
+    private:
+        const uint8_t * m_data;
+        uint16_t m_size;
+        uint16_t m_pos;
+};
+
+static uint8_t  g_frame[64];   /**< captured output frame   */
+
+/** Pull a frame row by row like Epd::paint()
+ */
+static void capture(
+    service::PixelSource& source,
+    uint16_t rowBytes, uint16_t rows)
+{
+    uint16_t used(0u);
+
+    TEST_ASSERT_TRUE((uint32_t)rowBytes * rows <= sizeof(g_frame));
+
+    for (uint16_t row(0u); row < rows; ++row)
+    {
+        uint16_t col(0u);
+
+        while (col < rowBytes)
+        {
+            uint8_t value(0u);
+            uint16_t count(source.next(value, rowBytes - col));
+
+            TEST_ASSERT_TRUE(0u < count);
+            TEST_ASSERT_TRUE(count <= rowBytes - col);
+            memset(&g_frame[used], value, count);
+            used += count;
+            col += count;
+        }
+    }
+}
+
+void test_window_placement(void)
+{
+    /* 8x4 frame (4 bytes per row), 4x2 window at 2,1 */
+    const uint8_t base[16] =
+    {
+        0x00, 0x01, 0x02, 0x03,
+        0x10, 0x11, 0x12, 0x13,
+        0x20, 0x21, 0x22, 0x23,
+        0x30, 0x31, 0x32, 0x33
+    };
+    const uint8_t data[] = { 0x44, 0x45, 0x54, 0x55 };
+    MemorySource outer(base, sizeof(base));
+    MemorySource inner(data, sizeof(data));
+    service::FrameWindow window;
+
+    TEST_ASSERT_TRUE(window.begin(8u, 4u, 2u, 1u, 4u, 2u, outer, inner));
+
+    capture(window, 4u, 4u);
+
+    /* base data under the window is skipped, not shifted */
+    const uint8_t expected[16] =
+    {
+        0x00, 0x01, 0x02, 0x03,
+        0x10, 0x44, 0x45, 0x13,
+        0x20, 0x54, 0x55, 0x23,
+        0x30, 0x31, 0x32, 0x33
+    };
+
+    TEST_ASSERT_EQUAL_MEMORY(expected, g_frame, sizeof(expected));
+}
+
+void test_window_limits(void)
+{
+    const uint8_t data[] = { 0x77, 0x66 };
+    const uint8_t base[] = { 0x22, 0x33 };
+    MemorySource outer(base, sizeof(base));
+    MemorySource inner(data, sizeof(data));
+    service::FrameWindow window;
+
+    /* odd x, too wide, too high */
+    TEST_ASSERT_FALSE(window.begin(8u, 4u, 1u, 0u, 4u, 2u, outer, inner));
+    TEST_ASSERT_FALSE(window.begin(8u, 4u, 6u, 0u, 4u, 2u, outer, inner));
+    TEST_ASSERT_FALSE(window.begin(8u, 4u, 0u, 3u, 4u, 2u, outer, inner));
+
+    /* full frame window, missing data becomes white */
+    TEST_ASSERT_TRUE(window.begin(8u, 4u, 0u, 0u, 8u, 4u, outer, inner));
+    capture(window, 4u, 4u);
+
+    TEST_ASSERT_EQUAL_HEX8(0x77u, g_frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x66u, g_frame[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x11u, g_frame[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x11u, g_frame[15]);
+
+    /* short base, missing outer data becomes white */
+    MemorySource inner2(data, sizeof(data));
+    MemorySource outer2(base, sizeof(base));
+
+    TEST_ASSERT_TRUE(window.begin(8u, 4u, 0u, 2u, 2u, 1u, outer2, inner2));
+    capture(window, 4u, 4u);
+
+    TEST_ASSERT_EQUAL_HEX8(0x22u, g_frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x33u, g_frame[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x11u, g_frame[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x77u, g_frame[8]);
+    TEST_ASSERT_EQUAL_HEX8(0x11u, g_frame[9]);
+}
@@ -0,0 +1,60 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of Governor */
+
+#include <unity.h>
+
+#include "service/Governor/Governor.cpp"
+
+void test_governor_curve(void)
+{
+    /* off */
+    TEST_ASSERT_EQUAL_UINT16(100u,
+        service::Governor::getStretch(3000u, 3300u, 0u, 400u));
+    TEST_ASSERT_EQUAL_UINT16(100u,
+        service::Governor::getStretch(3000u, 3300u, 3900u, 100u));
+
+    /* above the knee */
+    TEST_ASSERT_EQUAL_UINT16(100u,
+        service::Governor::getStretch(4200u, 3300u, 3900u, 400u));
+    TEST_ASSERT_EQUAL_UINT16(100u,
+        service::Governor::getStretch(3900u, 3300u, 3900u, 400u));
+
+    /* linear down to the limit */
+    TEST_ASSERT_EQUAL_UINT16(250u,
+        service::Governor::getStretch(3600u, 3300u, 3900u, 400u));
+    TEST_ASSERT_EQUAL_UINT16(400u,
+        service::Governor::getStretch(3300u, 3300u, 3900u, 400u));
+    TEST_ASSERT_EQUAL_UINT16(400u,
+        service::Governor::getStretch(3100u, 3300u, 3900u, 400u));
+}
@@ -0,0 +1,75 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of generated pixel sources */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "service/Display/PixelSource.cpp"
+
+/** Display stub, the direct path is not used here
+ */
+void service::Epd::fill(service::Epd::Color color)
+{
+    (void)color;
+}
+
+void test_pixel_solid(void)
+{
+    service::SolidSource solid(service::Epd::RED);
+    uint8_t value(0u);
+
+    TEST_ASSERT_EQUAL(300u, solid.next(value, 300u));
+    TEST_ASSERT_EQUAL_HEX8(0x44u, value);
+    TEST_ASSERT_EQUAL(1u, solid.next(value, 1u));
+}
+
+void test_pixel_pattern(void)
+{
+    /* 12 pixel rows (6 bytes), 4 pixel stripes (2 bytes) */
+    service::PatternSource pattern(12u, 0x0u, 0x5u, 4u);
+    uint8_t value(0u);
+
+    for (uint8_t row(0u); row < 2u; ++row)
+    {
+        TEST_ASSERT_EQUAL(2u, pattern.next(value, 6u));
+        TEST_ASSERT_EQUAL_HEX8(0x00u, value);
+        TEST_ASSERT_EQUAL(1u, pattern.next(value, 1u));
+        TEST_ASSERT_EQUAL_HEX8(0x55u, value);
+        TEST_ASSERT_EQUAL(1u, pattern.next(value, 3u));
+        TEST_ASSERT_EQUAL_HEX8(0x55u, value);
+        TEST_ASSERT_EQUAL(2u, pattern.next(value, 2u));
+        TEST_ASSERT_EQUAL_HEX8(0x00u, value);
+    }
+}
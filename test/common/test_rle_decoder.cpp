@@ -0,0 +1,118 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of RleDecoder */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "service/Image/RleDecoder.cpp"
+
+/** Decode code bytes into expanded output bytes
+ *
+ * @return number of bytes stored in out
+ */
+static uint16_t decode(
+    const uint8_t * codes, uint16_t size,
+    uint8_t * out, uint16_t outSize)
+{
+    service::RleDecoder decoder;
+    uint16_t used(0u);
+
+    for (uint16_t idx(0u); idx < size; ++idx)
+    {
+        if (decoder.put(codes[idx]))
+        {
+            uint8_t value;
+            uint16_t count;
+
+            while (decoder.get(value, count))
+            {
+                TEST_ASSERT_TRUE(0u < count);
+                TEST_ASSERT_TRUE(used + count <= outSize);
+                memset(&out[used], value, count);
+                used += count;
+            }
+        }
+    }
+
+    return used;
+}
+
+void test_rle_short_runs(void)
+{
+    /* 2x black, 4x white, 16x red */
+    const uint8_t codes[] = { 0x08, 0x19, 0x7C };
+    uint8_t out[16];
+
+    TEST_ASSERT_EQUAL(11u, decode(codes, sizeof(codes), out, sizeof(out)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x11, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x11, out[2]);
+    for (uint8_t idx(3u); idx < 11u; ++idx)
+    {
+        TEST_ASSERT_EQUAL_HEX8(0x44, out[idx]);
+    }
+}
+
+void test_rle_odd_runs(void)
+{
+    /* 1x green, 2x blue, 3x yellow, 1x orange, 1x black */
+    const uint8_t codes[] = { 0x02, 0x0B, 0x15, 0x06, 0x00 };
+    uint8_t out[8];
+
+    TEST_ASSERT_EQUAL(4u, decode(codes, sizeof(codes), out, sizeof(out)));
+    TEST_ASSERT_EQUAL_HEX8(0x23, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x35, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x55, out[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x60, out[3]);
+}
+
+void test_rle_long_runs(void)
+{
+    /* 17x white, 4112x clean, 1x white */
+    const uint8_t codes[] = { 0x81, 0x00, 0xFF, 0xFF, 0x01 };
+    static uint8_t out[2065];
+
+    TEST_ASSERT_EQUAL(2065u, decode(codes, sizeof(codes), out, sizeof(out)));
+    for (uint16_t idx(0u); idx < 8u; ++idx)
+    {
+        TEST_ASSERT_EQUAL_HEX8(0x11, out[idx]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0x17, out[8]);
+    for (uint16_t idx(9u); idx < 2064u; ++idx)
+    {
+        TEST_ASSERT_EQUAL_HEX8(0x77, out[idx]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0x71, out[2064]);
+}
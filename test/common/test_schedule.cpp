@@ -0,0 +1,97 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of Schedule */
+
+#include <unity.h>
+
+#include "service/Schedule/Schedule.cpp"
+
+/** seconds of a time of day */
+static uint32_t at(uint8_t hours, uint8_t minutes)
+{
+    return ((uint32_t)hours * 60u + minutes) * 60u;
+}
+
+void test_schedule_interval(void)
+{
+    service::Schedule::Table table = { 0u, 0u, 0u, {} };
+
+    TEST_ASSERT_EQUAL_UINT32(3600u,
+        service::Schedule::getSleepSeconds(table, at(12, 0), 60u));
+    TEST_ASSERT_EQUAL_UINT32(1u,
+        service::Schedule::getSleepSeconds(table, at(12, 0), 0u));
+    TEST_ASSERT_EQUAL_UINT32(5400u,
+        service::Schedule::getSleepSeconds(table, at(12, 0), 60u, 150u));
+    TEST_ASSERT_EQUAL_UINT32(service::Schedule::MAX_SLEEP_SECONDS,
+        service::Schedule::getSleepSeconds(table, at(12, 0), 65535u, 400u));
+
+    /* quiet hours 22:00 - 6:00 */
+    table.quietStart = 22u * 60u;
+    table.quietEnd = 6u * 60u;
+    TEST_ASSERT_EQUAL_UINT32(3600u,
+        service::Schedule::getSleepSeconds(table, at(20, 0), 60u));
+    TEST_ASSERT_EQUAL_UINT32(at(10, 0),
+        service::Schedule::getSleepSeconds(table, at(20, 0), 120u));
+    TEST_ASSERT_EQUAL_UINT32(at(8, 0),
+        service::Schedule::getSleepSeconds(table, at(22, 0), 1u));
+
+    TEST_ASSERT_TRUE(service::Schedule::inRange(23u * 60u, 22u * 60u, 6u * 60u));
+    TEST_ASSERT_TRUE(service::Schedule::inRange(0u, 22u * 60u, 6u * 60u));
+    TEST_ASSERT_FALSE(service::Schedule::inRange(6u * 60u, 22u * 60u, 6u * 60u));
+    TEST_ASSERT_TRUE(service::Schedule::inRange(100u, 300u, 300u));
+}
+
+void test_schedule_times(void)
+{
+    service::Schedule::Table table = { 0u, 0u, 2u, { 7u * 60u, 18u * 60u } };
+
+    TEST_ASSERT_EQUAL_UINT32(at(1, 0),
+        service::Schedule::getSleepSeconds(table, at(6, 0), 60u));
+    TEST_ASSERT_EQUAL_UINT32(at(11, 0),
+        service::Schedule::getSleepSeconds(table, at(7, 0), 60u));
+    TEST_ASSERT_EQUAL_UINT32(at(13, 0) - 30u,
+        service::Schedule::getSleepSeconds(table, at(18, 0) + 30u, 60u));
+
+    /* stretched sleep skips update times */
+    TEST_ASSERT_EQUAL_UINT32(at(12, 0),
+        service::Schedule::getSleepSeconds(table, at(6, 0), 60u, 200u));
+    TEST_ASSERT_EQUAL_UINT32(at(25, 0),
+        service::Schedule::getSleepSeconds(table, at(6, 0), 60u, 1300u));
+
+    /* an update time in the quiet hours moves to their end */
+    table.times[1] = 23u * 60u;
+    table.quietStart = 22u * 60u;
+    table.quietEnd = 6u * 60u + 30u;
+    TEST_ASSERT_EQUAL_UINT32(at(10, 30),
+        service::Schedule::getSleepSeconds(table, at(20, 0), 60u));
+}
@@ -0,0 +1,99 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Norbert Schulz
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** Unittesting of Shuffle */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "service/Shuffle/Shuffle.cpp"
+
+/** Walk one period and check every position shows up once
+ *
+ * @param count number of elements
+ * @param seed  permutation seed
+ */
+static void checkPermutation(uint16_t count, uint16_t seed)
+{
+    static uint8_t seen[1000];
+    service::Shuffle shuffle;
+
+    shuffle.begin(count, seed);
+    memset(seen, 0, sizeof(seen));
+
+    uint16_t pos(0u);
+    for (uint16_t step(0u); step < count; ++step)
+    {
+        pos = shuffle.next(pos);
+        TEST_ASSERT_TRUE(pos < count);
+        TEST_ASSERT_EQUAL(0u, seen[pos]);
+        seen[pos] = 1u;
+    }
+    TEST_ASSERT_EQUAL(0u, pos);   /* period is exactly count */
+}
+
+void test_shuffle_permutation(void)
+{
+    const uint16_t counts[] = { 1u, 2u, 3u, 7u, 8u, 9u, 100u, 513u, 1000u };
+
+    for (uint8_t idx(0u); idx < sizeof(counts) / sizeof(counts[0]); ++idx)
+    {
+        checkPermutation(counts[idx], 0u);
+        checkPermutation(counts[idx], 0x1234u);
+        checkPermutation(counts[idx], 0xFFFFu);
+    }
+}
+
+void test_shuffle_limits(void)
+{
+    service::Shuffle shuffle;
+
+    TEST_ASSERT_EQUAL(0u, shuffle.next(5u));   /* not set up */
+
+    shuffle.begin(10u, 0x4711u);
+    TEST_ASSERT_EQUAL(10u, shuffle.getCount());
+    TEST_ASSERT_TRUE(shuffle.next(60000u) < 10u);
+
+    /* different seeds give different orders */
+    service::Shuffle other;
+    other.begin(10u, 0x0815u);
+
+    bool differs(false);
+    uint16_t pos(0u);
+    for (uint8_t step(0u); step < 10u; ++step)
+    {
+        differs |= (shuffle.next(pos) != other.next(pos));
+        pos = shuffle.next(pos);
+    }
+    TEST_ASSERT_TRUE(differs);
+}